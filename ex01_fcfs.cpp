@@ -17,22 +17,23 @@ struct Process {
 
 // ---------- helpers ----------
 void calculateMetrics(vector<Process>& processes, int total_time) {
-    double avg_wait = 0, avg_turn = 0;
+    double avg_wait = 0, avg_turn = 0, busy = 0;
     for (auto& p : processes) {
         avg_wait += p.waiting_time;
         avg_turn += p.turnaround_time;
+        busy += p.burst_time;
     }
     avg_wait /= processes.size();
     avg_turn /= processes.size();
     cout << "Avg Waiting Time: " << avg_wait << "\n";
     cout << "Avg Turnaround Time: " << avg_turn << "\n";
-    cout << "CPU Utilization: 100%\n";  // simplified for now
+    cout << "CPU Utilization: " << (total_time > 0 ? 100 * busy / total_time : 0) << "%\n";
 }
 
-void printGantt(const vector<pair<string,int>>& gantt) {
+void printGantt(const vector<Process>& ps, const vector<pair<int,int>>& gantt) {
     cout << "Gantt Chart: ";
     for (auto& g : gantt)
-        cout << g.first << "(" << g.second << ") ";
+        cout << ps[g.first].id << "(" << g.second << ") ";
     cout << "\n";
 }
 
@@ -64,10 +65,11 @@ int main() {
              return a.arrival_time < b.arrival_time;
          });
 
-    vector<pair<string,int>> gantt;
+    vector<pair<int,int>> gantt;
     int current_time = 0;
 
-    for (auto &p : processes) {
+    for (int k = 0; k < (int)processes.size(); ++k) {
+        Process& p = processes[k];
         if (current_time < p.arrival_time)
             current_time = p.arrival_time;
 
@@ -75,10 +77,10 @@ int main() {
         current_time += p.burst_time;
         p.turnaround_time = current_time - p.arrival_time;
 
-        gantt.push_back({p.id, current_time});
+        gantt.push_back({k, current_time});
     }
 
-    printGantt(gantt);
+    printGantt(processes, gantt);
     calculateMetrics(processes, current_time);
     return 0;
 }
@@ -18,21 +18,22 @@ struct Process {
 
 // ---------- common helpers ----------
 void calculateMetrics(vector<Process>& processes, int total_time) {
-    double avg_wait = 0, avg_turn = 0;
+    double avg_wait = 0, avg_turn = 0, busy = 0;
     for (auto& p : processes) {
         avg_wait += p.waiting_time;
         avg_turn += p.turnaround_time;
+        busy += p.burst_time;
     }
     avg_wait /= processes.size();
     avg_turn /= processes.size();
     cout << "Avg Waiting Time: " << avg_wait << "\n";
     cout << "Avg Turnaround Time: " << avg_turn << "\n";
-    cout << "CPU Utilization: 100%\n"; // no idle with this dataset
+    cout << "CPU Utilization: " << (total_time > 0 ? 100 * busy / total_time : 0) << "%\n";
 }
 
-void printGantt(const vector<pair<string,int>>& gantt) {
+void printGantt(const vector<Process>& ps, const vector<pair<int,int>>& gantt) {
     cout << "Gantt Chart: ";
-    for (auto& g : gantt) cout << g.first << "(" << g.second << ") ";
+    for (auto& g : gantt) cout << ps[g.first].id << "(" << g.second << ") ";
     cout << "\n";
 }
 
@@ -67,7 +68,7 @@ int main() {
 
     int n = (int)processes.size();
     vector<bool> done(n, false);
-    vector<pair<string,int>> gantt; // {pid, cumulative_finish_time}
+    vector<pair<int,int>> gantt; // {pid, cumulative_finish_time}
     int finished = 0, current_time = 0;
 
     while (finished < n) {
@@ -101,12 +102,12 @@ int main() {
         current_time     += p.burst_time;
         p.turnaround_time = current_time - p.arrival_time;
 
-        gantt.push_back({p.id, current_time});
+        gantt.push_back({pick, current_time});
         done[pick] = true;
         ++finished;
     }
 
-    printGantt(gantt);
+    printGantt(processes, gantt);
     calculateMetrics(processes, current_time);
     return 0;
 }
@@ -17,22 +17,23 @@ struct Process {
 
 // ---------- common helpers ----------
 void calculateMetrics(vector<Process>& processes, int total_time) {
-    double avg_wait = 0, avg_turn = 0;
+    double avg_wait = 0, avg_turn = 0, busy = 0;
     for (auto& p : processes) {
         avg_wait += p.waiting_time;
         avg_turn += p.turnaround_time;
+        busy += p.burst_time;
     }
     avg_wait /= processes.size();
     avg_turn /= processes.size();
     cout << "Avg Waiting Time: " << avg_wait << "\n";
     cout << "Avg Turnaround Time: " << avg_turn << "\n";
-    cout << "CPU Utilization: 100%\n";
+    cout << "CPU Utilization: " << (total_time > 0 ? 100 * busy / total_time : 0) << "%\n";
 }
 
-void printGantt(const vector<pair<string,int>>& gantt) {
+void printGantt(const vector<Process>& ps, const vector<pair<int,int>>& gantt) {
     cout << "Gantt Chart: ";
     for (auto& g : gantt)
-        cout << g.first << "(" << g.second << ") ";
+        cout << ps[g.first].id << "(" << g.second << ") ";
     cout << "\n";
 }
 
@@ -68,7 +69,7 @@ int main() {
 
     const int n = (int)processes.size();
     vector<int> finish(n, -1);
-    vector<pair<string,int>> gantt; // (pid, cumulative_time_at_switch_or_finish)
+    vector<pair<int,int>> gantt; // (pid, cumulative_time_at_switch_or_finish)
     int time = 0, completed = 0, lastPick = -1;
 
     while (completed < n) {
@@ -99,7 +100,7 @@ int main() {
 
         // Context switch (record last slice)
         if (pick != lastPick && lastPick != -1)
-            gantt.push_back({processes[lastPick].id, time});
+            gantt.push_back({lastPick, time});
         lastPick = pick;
 
         // Run selected process for 1 time unit
@@ -115,7 +116,7 @@ int main() {
 
     // Record last running process end time
     if (lastPick != -1)
-        gantt.push_back({processes[lastPick].id, time});
+        gantt.push_back({lastPick, time});
 
     // Compute turnaround and waiting times
     for (int i = 0; i < n; ++i) {
@@ -123,7 +124,7 @@ int main() {
         processes[i].waiting_time = processes[i].turnaround_time - processes[i].burst_time;
     }
 
-    printGantt(gantt);
+    printGantt(processes, gantt);
     calculateMetrics(processes, time);
     return 0;
 }
@@ -18,15 +18,15 @@ struct Process {
 
 // ----- common helpers -----
 void calculateMetrics(vector<Process>& processes, int total_time) {
-    double avg_wait = 0, avg_turn = 0;
-    for (auto& p : processes) { avg_wait += p.waiting_time; avg_turn += p.turnaround_time; }
+    double avg_wait = 0, avg_turn = 0, busy = 0;
+    for (auto& p : processes) { avg_wait += p.waiting_time; avg_turn += p.turnaround_time; busy += p.burst_time; }
     avg_wait /= processes.size(); avg_turn /= processes.size();
     cout << "Avg Waiting Time: " << avg_wait << "\n";
     cout << "Avg Turnaround Time: " << avg_turn << "\n";
-    cout << "CPU Utilization: 100%\n";
+    cout << "CPU Utilization: " << (total_time > 0 ? 100 * busy / total_time : 0) << "%\n";
 }
-void printGantt(const vector<pair<string,int>>& gantt) {
-    cout << "Gantt Chart: "; for (auto& g : gantt) cout << g.first << "(" << g.second << ") "; cout << "\n";
+void printGantt(const vector<Process>& ps, const vector<pair<int,int>>& gantt) {
+    cout << "Gantt Chart: "; for (auto& g : gantt) cout << ps[g.first].id << "(" << g.second << ") "; cout << "\n";
 }
 vector<Process> loadDefaultTable() {
     return { {"P1",0,8,2,8,0,0}, {"P2",1,4,1,4,0,0}, {"P3",2,9,3,9,0,0}, {"P4",3,5,4,5,0,0} };
@@ -39,7 +39,7 @@ int main() {
     vector<Process> ps = loadDefaultTable(); reset(ps);
     sort(ps.begin(), ps.end(), [](auto&a, auto&b){ if(a.arrival_time!=b.arrival_time) return a.arrival_time<b.arrival_time; return a.id<b.id; });
 
-    queue<int> ready; vector<pair<string,int>> gantt;
+    queue<int> ready; vector<pair<int,int>> gantt;
     int n=ps.size(), done=0, t=0, i=0, last=-1;
 
     auto enqueue_arrivals = [&](int upto){
@@ -58,27 +58,25 @@ int main() {
         }
         int idx = ready.front(); ready.pop();
 
-        if(idx!=last && last!=-1) gantt.push_back({ps[last].id, t});
+        if(idx!=last && last!=-1) gantt.push_back({last, t});
         last = idx;
 
-        // run for up to QUANTUM, enqueuing arrivals as time advances
-        int ran = 0;
-        while(ran<QUANTUM && ps[idx].remaining_time>0){
-            ps[idx].remaining_time--; t++; ran++;
-            enqueue_arrivals(t);
-        }
+        // run for up to QUANTUM in one step, then enqueue everything that arrived meanwhile
+        int ran = min(QUANTUM, ps[idx].remaining_time);
+        ps[idx].remaining_time -= ran; t += ran;
+        enqueue_arrivals(t);
 
         if(ps[idx].remaining_time==0){
             ps[idx].turnaround_time = t - ps[idx].arrival_time;
             ps[idx].waiting_time    = ps[idx].turnaround_time - ps[idx].burst_time;
-            gantt.push_back({ps[idx].id, t});
+            gantt.push_back({idx, t});
             last=-1; done++;
         }else{
             ready.push(idx); // time slice expired; preempt
         }
     }
 
-    printGantt(gantt);
+    printGantt(ps, gantt);
     calculateMetrics(ps, t);
     return 0;
 }
@@ -17,13 +17,13 @@ struct Process {
 };
 
 void calculateMetrics(vector<Process>& processes, int total_time){
-    double aw=0, at=0; for(auto&p:processes){ aw+=p.waiting_time; at+=p.turnaround_time; }
+    double aw=0, at=0, bt=0; for(auto&p:processes){ aw+=p.waiting_time; at+=p.turnaround_time; bt+=p.burst_time; }
     aw/=processes.size(); at/=processes.size();
     cout<<"Avg Waiting Time: "<<aw<<"\n";
     cout<<"Avg Turnaround Time: "<<at<<"\n";
-    cout<<"CPU Utilization: 100%\n";
+    cout<<"CPU Utilization: "<<(total_time>0 ? 100*bt/total_time : 0)<<"%\n";
 }
-void printGantt(const vector<pair<string,int>>& g){ cout<<"Gantt Chart: "; for(auto&e:g) cout<<e.first<<"("<<e.second<<") "; cout<<"\n"; }
+void printGantt(const vector<Process>& ps, const vector<pair<int,int>>& g){ cout<<"Gantt Chart: "; for(auto&e:g) cout<<ps[e.first].id<<"("<<e.second<<") "; cout<<"\n"; }
 vector<Process> loadDefaultTable(){ return {{"P1",0,8,2,8,0,0},{"P2",1,4,1,4,0,0},{"P3",2,9,3,9,0,0},{"P4",3,5,4,5,0,0}}; }
 void reset(vector<Process>& ps){ for(auto& p:ps){ p.remaining_time=p.burst_time; p.waiting_time=p.turnaround_time=0; } }
 
@@ -34,7 +34,7 @@ int main(){
     int n=ps.size(), i=0, t=0, done=0, last=-1;
 
     queue<int> highQ, lowQ; 
-    vector<pair<string,int>> gantt;
+    vector<pair<int,int>> gantt;
 
     auto enqueue_arrivals = [&](int upto){
         while(i<n && ps[i].arrival_time<=upto){
@@ -55,38 +55,34 @@ int main(){
 
         if(!highQ.empty()){
             int idx = highQ.front(); highQ.pop();
-            if(idx!=last && last!=-1) gantt.push_back({ps[last].id, t});
+            if(idx!=last && last!=-1) gantt.push_back({last, t});
             last = idx;
 
-            int ran=0;
-            while(ran<HIGH_Q_QUANTUM && ps[idx].remaining_time>0){
-                ps[idx].remaining_time--; t++; ran++; enqueue_arrivals(t);
-            }
+            int ran = min(HIGH_Q_QUANTUM, ps[idx].remaining_time);
+            ps[idx].remaining_time -= ran; t += ran; enqueue_arrivals(t);
 
             if(ps[idx].remaining_time==0){
                 ps[idx].turnaround_time = t - ps[idx].arrival_time;
                 ps[idx].waiting_time    = ps[idx].turnaround_time - ps[idx].burst_time;
-                gantt.push_back({ps[idx].id, t}); last=-1; done++;
+                gantt.push_back({idx, t}); last=-1; done++;
             }else{
                 highQ.push(idx); // RR rotate
             }
         }else{
             // low queue FCFS 
             int idx = lowQ.front(); lowQ.pop();
-            if(idx!=last && last!=-1) gantt.push_back({ps[last].id, t});
+            if(idx!=last && last!=-1) gantt.push_back({last, t});
             last = idx;
 
             // run to completion; still accept arrivals (go into appropriate queue)
-            while(ps[idx].remaining_time>0){
-                ps[idx].remaining_time--; t++; enqueue_arrivals(t);
-            }
+            t += ps[idx].remaining_time; ps[idx].remaining_time = 0; enqueue_arrivals(t);
             ps[idx].turnaround_time = t - ps[idx].arrival_time;
             ps[idx].waiting_time    = ps[idx].turnaround_time - ps[idx].burst_time;
-            gantt.push_back({ps[idx].id, t}); last=-1; done++;
+            gantt.push_back({idx, t}); last=-1; done++;
         }
     }
 
-    printGantt(gantt);
+    printGantt(ps, gantt);
     calculateMetrics(ps, t);
     return 0;
 }
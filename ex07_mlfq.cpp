@@ -19,13 +19,13 @@ struct Process {
 };
 
 void calculateMetrics(vector<Process>& processes, int total_time){
-    double aw=0, at=0; for(auto&p:processes){ aw+=p.waiting_time; at+=p.turnaround_time; }
+    double aw=0, at=0, bt=0; for(auto&p:processes){ aw+=p.waiting_time; at+=p.turnaround_time; bt+=p.burst_time; }
     aw/=processes.size(); at/=processes.size();
     cout<<"Avg Waiting Time: "<<aw<<"\n";
     cout<<"Avg Turnaround Time: "<<at<<"\n";
-    cout<<"CPU Utilization: 100%\n";
+    cout<<"CPU Utilization: "<<(total_time>0 ? 100*bt/total_time : 0)<<"%\n";
 }
-void printGantt(const vector<pair<string,int>>& g){ cout<<"Gantt Chart: "; for(auto&e:g) cout<<e.first<<"("<<e.second<<") "; cout<<"\n"; }
+void printGantt(const vector<Process>& ps, const vector<pair<int,int>>& g){ cout<<"Gantt Chart: "; for(auto&e:g) cout<<ps[e.first].id<<"("<<e.second<<") "; cout<<"\n"; }
 vector<Process> loadDefaultTable(){
     return {
         {"P1",0,8,2,8,0,0,0,0},
@@ -45,7 +45,7 @@ int main(){
 
     int n=ps.size(), i=0, t=0, done=0, last=-1;
     queue<int> Q0, Q1, Q2;
-    vector<pair<string,int>> gantt;
+    vector<pair<int,int>> gantt;
 
     auto enqueue_arrivals = [&](int upto){
         while(i<n && ps[i].arrival_time<=upto){
@@ -93,7 +93,7 @@ int main(){
         }
 
         if(idx!=-1){
-            if(idx!=last && last!=-1) gantt.push_back({ps[last].id, t});
+            if(idx!=last && last!=-1) gantt.push_back({last, t});
             last = idx;
 
             int ran = 0;
@@ -106,7 +106,7 @@ int main(){
             if(ps[idx].remaining_time==0){
                 ps[idx].turnaround_time = t - ps[idx].arrival_time;
                 ps[idx].waiting_time    = ps[idx].turnaround_time - ps[idx].burst_time;
-                gantt.push_back({ps[idx].id, t}); last=-1; done++;
+                gantt.push_back({idx, t}); last=-1; done++;
             } else {
                 // time slice expired → demote (unless already at bottom)
                 ps[idx].queue_level = min(2, qlvl+1);
@@ -118,7 +118,7 @@ int main(){
         }
     }
 
-    printGantt(gantt);
+    printGantt(ps, gantt);
     calculateMetrics(ps, t);
     return 0;
 }
@@ -18,14 +18,14 @@ struct Process {
 };
 
 void calculateMetrics(vector<Process>& ps, int total_time){
-    double aw=0, at=0; for(auto& p:ps){ aw+=p.waiting_time; at+=p.turnaround_time; }
+    double aw=0, at=0, bt=0; for(auto& p:ps){ aw+=p.waiting_time; at+=p.turnaround_time; bt+=p.burst_time; }
     aw/=ps.size(); at/=ps.size();
     cout<<"Avg Waiting Time: "<<aw<<"\n";
     cout<<"Avg Turnaround Time: "<<at<<"\n";
-    cout<<"CPU Utilization: 100%\n";
+    cout<<"CPU Utilization: "<<(total_time>0 ? 100*bt/total_time : 0)<<"%\n";
 }
-void printGantt(const vector<pair<string,int>>& g){
-    cout<<"Gantt Chart: "; for(auto&e:g) cout<<e.first<<"("<<e.second<<") "; cout<<"\n";
+void printGantt(const vector<Process>& ps, const vector<pair<int,int>>& g){
+    cout<<"Gantt Chart: "; for(auto&e:g) cout<<ps[e.first].id<<"("<<e.second<<") "; cout<<"\n";
 }
 vector<Process> loadDefaultTable(){
     return { {"P1",0,8,2,8,0,0}, {"P2",1,4,1,4,0,0}, {"P3",2,9,3,9,0,0}, {"P4",3,5,4,5,0,0} };
@@ -38,7 +38,7 @@ int main(){
     sort(ps.begin(), ps.end(), [](auto&a, auto&b){ if(a.arrival_time!=b.arrival_time) return a.arrival_time<b.arrival_time; return a.id<b.id; });
 
     int n=ps.size(), i=0, t=0, done=0, last=-1;
-    vector<pair<string,int>> gantt;
+    vector<pair<int,int>> gantt;
 
     auto tickets_for = [&](int prio){ int base = 5 - prio; if(base<1) base=1; return base*10; };
 
@@ -50,24 +50,24 @@ int main(){
     if(ps[0].arrival_time>0) t = ps[0].arrival_time;
     enqueue_until(t);
 
+    vector<int> ready; ready.reserve(n);   // reused every decision
     while(done<n){
         // collect ready indices
-        vector<int> ready;
+        ready.clear();
         for(int k=0;k<n;++k) if(ps[k].remaining_time>0 && ps[k].arrival_time<=t) ready.push_back(k);
 
         if(ready.empty()){
             if(i<n){ t = max(t, ps[i].arrival_time); enqueue_until(t); continue; }
         }else{
-            // build ticket pool
-            vector<int> pool;
-            for(int idx: ready){
-                int tk = tickets_for(ps[idx].priority);
-                for(int c=0;c<tk;++c) pool.push_back(idx);
-            }
-            uniform_int_distribution<int> dist(0, (int)pool.size()-1);
-            int pick = pool[dist(rng)];
+            // draw a ticket; walking the ready list picks the same job as
+            // indexing a materialised pool of every ticket
+            int total=0;
+            for(int idx: ready) total += tickets_for(ps[idx].priority);
+            uniform_int_distribution<int> dist(0, total-1);
+            int r = dist(rng), pick = ready.back();
+            for(int idx: ready){ int tk = tickets_for(ps[idx].priority); if(r<tk){ pick=idx; break; } r-=tk; }
 
-            if(pick!=last && last!=-1) gantt.push_back({ps[last].id, t});
+            if(pick!=last && last!=-1) gantt.push_back({last, t});
             last = pick;
 
             int ran=0;
@@ -78,12 +78,12 @@ int main(){
             if(ps[pick].remaining_time==0){
                 ps[pick].turnaround_time = t - ps[pick].arrival_time;
                 ps[pick].waiting_time    = ps[pick].turnaround_time - ps[pick].burst_time;
-                gantt.push_back({ps[pick].id, t}); last=-1; done++;
+                gantt.push_back({pick, t}); last=-1; done++;
             }
         }
     }
 
-    printGantt(gantt);
+    printGantt(ps, gantt);
     calculateMetrics(ps, t);
     return 0;
 }
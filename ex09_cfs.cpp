@@ -18,14 +18,14 @@ struct Process {
 };
 
 void calculateMetrics(vector<Process>& ps, int total_time){
-    double aw=0, at=0; for(auto& p:ps){ aw+=p.waiting_time; at+=p.turnaround_time; }
+    double aw=0, at=0, bt=0; for(auto& p:ps){ aw+=p.waiting_time; at+=p.turnaround_time; bt+=p.burst_time; }
     aw/=ps.size(); at/=ps.size();
     cout<<"Avg Waiting Time: "<<aw<<"\n";
     cout<<"Avg Turnaround Time: "<<at<<"\n";
-    cout<<"CPU Utilization: 100%\n";
+    cout<<"CPU Utilization: "<<(total_time>0 ? 100*bt/total_time : 0)<<"%\n";
 }
-void printGantt(const vector<pair<string,int>>& g){
-    cout<<"Gantt Chart: "; for(auto&e:g) cout<<e.first<<"("<<e.second<<") "; cout<<"\n";
+void printGantt(const vector<Process>& ps, const vector<pair<int,int>>& g){
+    cout<<"Gantt Chart: "; for(auto&e:g) cout<<ps[e.first].id<<"("<<e.second<<") "; cout<<"\n";
 }
 vector<Process> loadDefaultTable(){
     return {
@@ -45,16 +45,17 @@ int main(){
     sort(ps.begin(), ps.end(), [](auto&a, auto&b){ if(a.arrival_time!=b.arrival_time) return a.arrival_time<b.arrival_time; return a.id<b.id; });
 
     int n=ps.size(), i=0, t=0, done=0, last=-1;
-    vector<pair<string,int>> gantt;
+    vector<pair<int,int>> gantt;
 
     auto enqueue_until = [&](int upto){ while(i<n && ps[i].arrival_time<=upto){ ++i; } };
 
     if(ps[0].arrival_time>0) t=ps[0].arrival_time;
     enqueue_until(t);
 
+    vector<int> ready; ready.reserve(n);   // reused every decision
     while(done<n){
         // gather ready
-        vector<int> ready;
+        ready.clear();
         for(int k=0;k<n;++k) if(ps[k].remaining_time>0 && ps[k].arrival_time<=t) ready.push_back(k);
 
         if(ready.empty()){
@@ -72,7 +73,7 @@ int main(){
             }
         }
 
-        if(pick!=last && last!=-1) gantt.push_back({ps[last].id, t});
+        if(pick!=last && last!=-1) gantt.push_back({last, t});
         last = pick;
 
         // run for up to BASE_SLICE, but tick-wise to account for arrivals and vruntime
@@ -88,11 +89,11 @@ int main(){
         if(ps[pick].remaining_time==0){
             ps[pick].turnaround_time = t - ps[pick].arrival_time;
             ps[pick].waiting_time    = ps[pick].turnaround_time - ps[pick].burst_time;
-            gantt.push_back({ps[pick].id, t}); last=-1; done++;
+            gantt.push_back({pick, t}); last=-1; done++;
         }
     }
 
-    printGantt(gantt);
+    printGantt(ps, gantt);
     calculateMetrics(ps, t);
     return 0;
 }
@@ -1,4 +1,17 @@
 #include <bits/stdc++.h>
+#include <malloc.h>
+#include <thread>
+#include <charconv>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
 using namespace std;
 
 
@@ -7,254 +20,2901 @@ struct Process {
     int arrival_time;
     int burst_time;
     int priority;        // lower number = higher priority (when used)
-    int remaining_time;  // for preemptive/RR
-    int waiting_time = 0;
-    int turnaround_time = 0;
     int deadline = -1;   // optional (e.g., EDF)
+    int tickets = -1;    // optional (lottery); <=0 derives from priority
+};
+
+// The priority engines keep one aging bucket per priority value, so loaders
+// reject rows above this rather than size the buckets from the input.
+static constexpr int kMaxPriority = 9999;
+
+struct MappedFile;
+
+/* Structure-of-arrays workload every engine runs on, sorted by (arrival, id).
+   Ids are interned so that id[k] is the rank of row k's name among all distinct
+   names: comparing ranks orders ids like the strings, which are only looked up
+   for output. Columns point at the owned vectors below or straight into an
+   mmapped binary workload. Generated tables store no names: rank r is named
+   "P" + (r+1) zero-padded to nameDigits, so name order is rank order. */
+struct ProcTable {
+    size_t n = 0, idCount = 0;
+    const int32_t *arrival = nullptr, *burst = nullptr, *priority = nullptr;
+    const int32_t *deadline = nullptr, *tickets = nullptr;
+    const uint32_t *id = nullptr;
+    const uint64_t *nameOff = nullptr;   // name of rank r is nameBlob[nameOff[r], nameOff[r+1])
+    const char *nameBlob = nullptr;
+    int nameDigits = 0;                  // > 0: names are generated, see above
+
+    size_t size() const { return n; }
+    // a generated name lives in a per-thread buffer until the next call
+    string_view name(size_t k) const {
+        uint32_t r = id[k];
+        if (nameDigits) {
+            thread_local char buf[16];
+            buf[0] = 'P';
+            uint64_t v = uint64_t(r) + 1;
+            for (int d = nameDigits; d > 0; d--, v /= 10) buf[d] = '0' + v % 10;
+            return string_view(buf, nameDigits + 1);
+        }
+        return string_view(nameBlob + nameOff[r], nameOff[r+1] - nameOff[r]);
+    }
+
+    // backing storage; moving the table keeps every pointer above valid
+    vector<int32_t> cols[5];
+    vector<uint32_t> ids;
+    vector<uint64_t> offs;
+    vector<char> blob;
+    shared_ptr<MappedFile> mapping;
+
+    ProcTable() = default;
+    ProcTable(ProcTable&&) = default;
+    ProcTable& operator=(ProcTable&&) = default;
+    ProcTable(const ProcTable&) = delete;
+    ProcTable& operator=(const ProcTable&) = delete;
+};
+
+// Interns ids, sorts rows by (arrival, id rank) and splits them into columns
+static ProcTable makeTable(vector<Process> rows) {
+    ProcTable T;
+    const size_t n = rows.size();
+
+    // sort names once; equal names share a rank. The first 8 bytes, packed
+    // big-endian, decide most comparisons without touching the strings.
+    struct NameKey { uint64_t prefix; string_view name; uint32_t row; };
+    vector<NameKey> byName(n);
+    for (size_t k=0; k<n; k++) {
+        string_view v = rows[k].id;
+        uint64_t pre = 0;
+        for (size_t c=0; c<8; c++) pre = pre<<8 | (c<v.size() ? (unsigned char)v[c] : 0);
+        byName[k] = {pre, v, (uint32_t)k};
+    }
+    sort(byName.begin(), byName.end(), [](const NameKey& a, const NameKey& b){
+        if (a.prefix!=b.prefix) return a.prefix<b.prefix;
+        return a.name<b.name;
+    });
+    vector<uint32_t> rank(n);
+    T.offs.push_back(0);
+    for (size_t k=0; k<n; k++) {
+        if (k==0 || byName[k].name != byName[k-1].name) {
+            T.blob.insert(T.blob.end(), byName[k].name.begin(), byName[k].name.end());
+            T.offs.push_back(T.blob.size());
+        }
+        rank[byName[k].row] = T.offs.size() - 2;
+    }
+    T.idCount = T.offs.size() - 1;
+    vector<NameKey>().swap(byName);
+
+    vector<uint32_t> order(n);
+    iota(order.begin(), order.end(), 0);
+    auto before = [&](uint32_t a, uint32_t b){
+        if (rows[a].arrival_time!=rows[b].arrival_time) return rows[a].arrival_time<rows[b].arrival_time;
+        return rank[a]<rank[b];
+    };
+    if (!is_sorted(order.begin(), order.end(), before)) sort(order.begin(), order.end(), before);
+
+    for (auto &c : T.cols) c.resize(n);
+    T.ids.resize(n);
+    for (size_t k=0; k<n; k++) {
+        const Process& p = rows[order[k]];
+        T.cols[0][k] = p.arrival_time;
+        T.cols[1][k] = p.burst_time;
+        T.cols[2][k] = p.priority;
+        T.cols[3][k] = p.deadline;
+        T.cols[4][k] = p.tickets;
+        T.ids[k] = rank[order[k]];
+    }
+    T.n = n;
+    T.arrival = T.cols[0].data(); T.burst = T.cols[1].data(); T.priority = T.cols[2].data();
+    T.deadline = T.cols[3].data(); T.tickets = T.cols[4].data();
+    T.id = T.ids.data();
+    T.nameOff = T.offs.data();
+    T.nameBlob = T.blob.data();
+    return T;
+}
+
+// Per-process outputs of one run, indexed like the (sorted) workload. Callers
+// own these and can reuse one instance across runs without reallocating.
+struct RunArrays {
+    vector<int> waiting, turnaround;
+    vector<int> response;    // first dispatch - arrival; -1 until the job first runs
+    vector<int> remaining;   // scratch for preemptive policies
+};
+
+// EDF falls back to the lab's rule when the CSV gives no deadline
+static int deadlineOf(const Process& p) {
+    return p.deadline >= 0 ? p.deadline : p.arrival_time + 2*p.burst_time;
+}
+static int deadlineOf(const ProcTable& ps, int k) {
+    return ps.deadline[k] >= 0 ? ps.deadline[k] : ps.arrival[k] + 2*ps.burst[k];
+}
+
+/* Byte streams for engine snapshots (see Checkpoints below). State goes out as
+   plain values and arrays in native layout, never as pointers; `rows` arrays are
+   indexed by table row and read back over the first entries of a possibly longer
+   table, `items` arrays (queue and heap contents) are read back at their size. */
+struct SnapWriter {
+    string buf;
+    template <class T> void val(const T& v) { buf.append(reinterpret_cast<const char*>(&v), sizeof v); }
+    template <class T> void items(const T* p, size_t n) {
+        val<uint64_t>(n);
+        buf.append(reinterpret_cast<const char*>(p), n * sizeof(T));
+    }
+    template <class T> void items(const vector<T>& v) { items(v.data(), v.size()); }
+    template <class T> void rows(const vector<T>& v, size_t cut) { items(v.data(), cut); }
+    void str(const string& s) { items(s.data(), s.size()); }
+};
+
+class SnapReader {
+    const char *p, *e;
+    const char* take(size_t bytes) {
+        if (bytes > (size_t)(e - p)) throw runtime_error("Bad snapshot (truncated)");
+        const char* at = p; p += bytes; return at;
+    }
+    template <class T> size_t count() {
+        uint64_t n = val<uint64_t>();
+        if (n > (size_t)(e - p) / sizeof(T)) throw runtime_error("Bad snapshot (truncated)");
+        return n;
+    }
+public:
+    explicit SnapReader(const string& s): p(s.data()), e(s.data() + s.size()) {}
+    template <class T> T val() { T v; memcpy(&v, take(sizeof v), sizeof v); return v; }
+    template <class T> void val(T& v) { v = val<T>(); }
+    template <class T> void items(vector<T>& v) {
+        size_t n = count<T>();
+        v.resize(n);
+        memcpy(static_cast<void*>(v.data()), take(n * sizeof(T)), n * sizeof(T));
+    }
+    template <class T> size_t rows(vector<T>& v) {
+        size_t n = count<T>();
+        if (n > v.size()) throw runtime_error("Bad snapshot (more rows than the workload)");
+        memcpy(static_cast<void*>(v.data()), take(n * sizeof(T)), n * sizeof(T));
+        return n;
+    }
+    string str() { size_t n = count<char>(); return string(take(n), n); }
+    bool done() const { return p == e; }
+};
+
+/* HDR-style log-linear histogram: values below 2^(S+1) are exact, larger ones
+   fall into one of 2^S sub-buckets per power of two (relative error < 2^-S).
+   The bucket array has a fixed size, so memory does not grow with the job
+   count, and histograms from separate runs or shards merge by adding counts. */
+struct LatencySummary {
+    double mean = 0;
+    long long p50 = 0, p90 = 0, p99 = 0, p999 = 0, max = 0;
+};
+
+class LatencyHistogram {
+    static constexpr int S = 7;
+    static constexpr int kBuckets = (64 - S + 1) << S;
+    vector<uint64_t> counts = vector<uint64_t>(kBuckets);
+    uint64_t n = 0;
+    long double sum = 0;
+    long long lo = LLONG_MAX, hi = 0;
+
+    static int bucketOf(uint64_t v) {
+        if (v < (2u << S)) return (int)v;
+        int shift = 63 - __builtin_clzll(v) - S;
+        return ((shift + 1) << S) + (int)(v >> shift) - (1 << S);
+    }
+    static long long highestIn(int b) {     // largest value mapping to bucket b
+        if (b < (2 << S)) return b;
+        int shift = (b >> S) - 1;
+        uint64_t low = (uint64_t)((b & ((1 << S) - 1)) + (1 << S)) << shift;
+        return (long long)min<uint64_t>(low + ((uint64_t)1 << shift) - 1, LLONG_MAX);
+    }
+public:
+    void record(long long v) {
+        v = max(0LL, v);
+        counts[bucketOf(v)]++; n++; sum += v;
+        lo = min(lo, v); hi = max(hi, v);
+    }
+    void merge(const LatencyHistogram& o) {
+        for (int b=0; b<kBuckets; b++) counts[b] += o.counts[b];
+        n += o.n; sum += o.sum; lo = min(lo, o.lo); hi = max(hi, o.hi);
+    }
+    uint64_t count() const { return n; }
+    void save(SnapWriter& w) const { w.items(counts); w.val(n); w.val(sum); w.val(lo); w.val(hi); }
+    void load(SnapReader& r) {
+        r.items(counts);
+        if (counts.size() != kBuckets) throw runtime_error("Bad snapshot (histogram)");
+        r.val(n); r.val(sum); r.val(lo); r.val(hi);
+    }
+    // nearest rank, reported as the bucket's highest value clamped to the observed range
+    long long percentile(double q) const {
+        if (!n) return 0;
+        uint64_t rank = max<uint64_t>(1, (uint64_t)ceil(q * n)), seen = 0;
+        for (int b=0; b<kBuckets; b++)
+            if ((seen += counts[b]) >= rank) return max(lo, min(hi, highestIn(b)));
+        return hi;
+    }
+    LatencySummary summary() const {
+        if (!n) return {};
+        return {(double)(sum / n), percentile(0.50), percentile(0.90), percentile(0.99),
+                percentile(0.999), hi};
+    }
+};
+
+struct Metrics {
+    double avg_wait = 0, avg_turn = 0, cpu_util = 0, throughput = 0;
+    long long busy = 0, idle = 0;       // CPU time split of [0, total_time]
+    LatencySummary wait, turn, resp;
+};
+
+// Fed one finished job at a time, so metrics need no per-job storage
+struct MetricsAcc {
+    long long jobs = 0;
+    double sumWait = 0, sumTurn = 0;
+    LatencyHistogram wait, turn, resp;
+    void add(long long w, long long t, long long r) {
+        jobs++; sumWait += w; sumTurn += t;
+        wait.record(w); turn.record(t); resp.record(r);
+    }
+    void save(SnapWriter& w) const { w.val(jobs); w.val(sumWait); w.val(sumTurn); wait.save(w); turn.save(w); resp.save(w); }
+    void load(SnapReader& r) { r.val(jobs); r.val(sumWait); r.val(sumTurn); wait.load(r); turn.load(r); resp.load(r); }
+    // capacity: CPU time available over the run (cpus * total_time)
+    Metrics finish(long long capacity, long long idle, long long total_time) const {
+        Metrics m;
+        if (jobs) { m.avg_wait = sumWait / jobs; m.avg_turn = sumTurn / jobs; }
+        m.idle = idle;
+        m.busy = capacity - idle;
+        m.cpu_util = (capacity > 0) ? (100.0 * m.busy / capacity) : 0.0;
+        m.throughput = (total_time > 0) ? (double)jobs / total_time : 0.0;
+        m.wait = wait.summary(); m.turn = turn.summary(); m.resp = resp.summary();
+        return m;
+    }
+};
+
+class TraceWriter;
+struct SchedStats;
+class Checkpointer;
+struct Snapshot;
+
+struct CPUStat {                    // SMP mode only
+    long long busy = 0, dispatches = 0, migrations = 0;    // migrations onto this CPU
+    vector<pair<int,int>> gantt;
 };
 
 struct SimResult {
-    vector<pair<string,int>> gantt; // (pid, cumulative_finish_or_switch_time)
+    vector<pair<int,int>> gantt;    // (row, cumulative_finish_or_switch_time)
     int total_time = 0;
+    long long decisions = 0;        // dispatches made by the policy
+    long long idle = 0;             // CPU time with nothing ready, summed over CPUs
+    int cpus = 1;
+    vector<CPUStat> cpu;            // per-CPU stats and Gantt charts in SMP mode
+    uint64_t setupAllocs = 0, loopAllocs = 0;   // heap allocations before / inside the event loop
+    bool keepGantt = true;          // false: the schedule only goes to `trace`, if any
+    TraceWriter* trace = nullptr;
+    SchedStats* stats = nullptr;    // --stats counters, when collected
+    Checkpointer* checkpoint = nullptr;   // snapshots to take, single-CPU engines only
+    const Snapshot* resume = nullptr;     // state to start from instead of t=0
+    MetricsAcc acc;                 // filled as jobs complete
+    Metrics metrics;
+};
+
+// formatted in 64 KiB blocks rather than one stream insertion per field
+static void printGantt(const ProcTable& ps, const vector<pair<int,int>>& gantt, const string& label = "") {
+    string s = "Gantt Chart" + label + ": ";
+    s.reserve(1 << 16);
+    char num[16];
+    for (auto &e : gantt) {
+        s += ps.name(e.first); s += '(';
+        s.append(num, to_chars(num, num + 16, e.second).ptr);
+        s += ") ";
+        if (s.size() > (1 << 16) - 64) { cout.write(s.data(), s.size()); s.clear(); }
+    }
+    s += '\n';
+    cout.write(s.data(), s.size());
+}
+
+static void printLatency(const char* label, const LatencySummary& l) {
+    cout << label << " p50/p90/p99/p99.9/max: " << l.p50 << "/" << l.p90 << "/" << l.p99
+         << "/" << l.p999 << "/" << l.max << "\n";
+}
+
+static void printMetrics(const Metrics& m) {
+    cout << "Avg Waiting Time: " << m.avg_wait << "\n";
+    cout << "Avg Turnaround Time: " << m.avg_turn << "\n";
+    cout << "CPU Utilization: " << m.cpu_util << "%\n";
+    cout << "Throughput (jobs / time): " << m.throughput << "\n";
+    cout << "Busy/Idle Time: " << m.busy << "/" << m.idle << "\n";
+    printLatency("Waiting", m.wait);
+    printLatency("Turnaround", m.turn);
+    printLatency("Response", m.resp);
+}
+
+static void writeLatencyJson(ostream& f, const char* name, const LatencySummary& l) {
+    f << "\"" << name << "\": {\"mean\": " << l.mean << ", \"p50\": " << l.p50 << ", \"p90\": " << l.p90
+      << ", \"p99\": " << l.p99 << ", \"p99_9\": " << l.p999 << ", \"max\": " << l.max << "}";
+}
+
+// Metrics as the body of a JSON object (no braces) so callers can add run fields
+static void writeMetricsJson(ostream& f, const Metrics& m) {
+    f << "\"avg_wait\": " << m.avg_wait << ", \"avg_turnaround\": " << m.avg_turn
+      << ", \"cpu_util\": " << m.cpu_util << ", \"throughput\": " << m.throughput
+      << ", \"busy\": " << m.busy << ", \"idle\": " << m.idle << ", ";
+    writeLatencyJson(f, "waiting", m.wait); f << ", ";
+    writeLatencyJson(f, "turnaround", m.turn); f << ", ";
+    writeLatencyJson(f, "response", m.resp);
+}
+
+// --metrics-json: a single object, or an array when several runs are written
+static void writeMetricsFile(const string& file, const vector<pair<string, Metrics>>& runs) {
+    ofstream f(file);
+    if (!f) throw runtime_error("Failed to open metrics output: " + file);
+    if (runs.size() != 1) f << "[\n";
+    for (size_t k=0; k<runs.size(); k++) {
+        f << (runs.size() != 1 ? "  {" : "{") << runs[k].first;
+        writeMetricsJson(f, runs[k].second);
+        f << "}" << (k+1<runs.size() ? ",\n" : "\n");
+    }
+    if (runs.size() != 1) f << "]\n";
+}
+
+/* EDF extras: deadline misses, max lateness and tardiness percentiles (nearest rank) */
+static void printDeadlineMetrics(const ProcTable& ps, const RunArrays& out) {
+    vector<int> tard;
+    tard.reserve(ps.size());
+    int misses = 0, max_late = INT_MIN;
+    for (size_t k=0; k<ps.size(); k++) {
+        int late = ps.arrival[k] + out.turnaround[k] - deadlineOf(ps, k);
+        max_late = max(max_late, late);
+        if (late > 0) misses++;
+        tard.push_back(max(0, late));
+    }
+    sort(tard.begin(), tard.end());
+    auto pct = [&](double q){ return tard[(size_t)ceil(q * tard.size()) - 1]; };
+
+    cout << "Deadline Misses: " << misses << "/" << ps.size() << "\n";
+    cout << "Max Lateness: " << max_late << "\n";
+    cout << "Tardiness p50/p90/p99: " << pct(0.50) << "/" << pct(0.90) << "/" << pct(0.99) << "\n";
+}
+
+/* Default table (matches your doc) */
+static vector<Process> defaultTable() {
+    return {
+        {"P1", 0, 8, 2},
+        {"P2", 1, 4, 1},
+        {"P3", 2, 9, 3},
+        {"P4", 3, 5, 4},
+    };
+}
+
+/* Read-only mmap of a whole file; unmapped on scope exit */
+struct MappedFile {
+    const char* data = nullptr;
+    size_t size = 0;
+    explicit MappedFile(const string& filename) {
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0) throw runtime_error("Failed to open input file: " + filename);
+        struct stat st{};
+        if (fstat(fd, &st) != 0) { close(fd); throw runtime_error("Failed to stat input file: " + filename); }
+        size = st.st_size;
+        if (size > 0) {
+            void* m = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (m == MAP_FAILED) { close(fd); throw runtime_error("Failed to mmap input file: " + filename); }
+            madvise(m, size, MADV_SEQUENTIAL);
+            data = static_cast<const char*>(m);
+        }
+        close(fd);
+    }
+    ~MappedFile() { if (data) munmap(const_cast<char*>(data), size); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+};
+
+enum class RowKind { Blank, Header, Bad, Ok };
+
+// Parses one line [q, eol). Fields are separated by commas and/or whitespace:
+// id,arrival,burst[,priority[,deadline[,tickets]]]. `first` marks the first
+// non-empty line of the input, which is a header when its second field isn't an integer.
+static RowKind parseCSVRow(const char* q, const char* eol, bool first, Process& out) {
+    auto isSep = [](char ch){ return ch==',' || ch==' ' || ch=='\t' || ch=='\r'; };
+    // split into at most 7 fields (7th means trailing junk)
+    string_view f[7];
+    int nf = 0;
+    while (nf < 7) {
+        while (q < eol && isSep(*q)) q++;
+        if (q == eol) break;
+        const char* st = q;
+        while (q < eol && !isSep(*q)) q++;
+        f[nf++] = string_view(st, q - st);
+    }
+    if (nf == 0) return RowKind::Blank;
+
+    auto num = [](string_view v, int& x){
+        auto r = from_chars(v.data(), v.data() + v.size(), x);
+        return r.ec == errc() && r.ptr == v.data() + v.size();
+    };
+    int a, bt, p = 3, d = -1, tk = -1; // default priority if missing
+    if (nf < 2 || !num(f[1], a)) return first ? RowKind::Header : RowKind::Bad;
+    if (nf < 3 || nf > 6 || !num(f[2], bt) ||
+        (nf > 3 && !num(f[3], p)) || (nf > 4 && !num(f[4], d)) || (nf > 5 && !num(f[5], tk)) ||
+        a < 0 || bt < 0 || p > kMaxPriority)
+        return RowKind::Bad;
+    out = {string(f[0]), a, bt, p, d, tk};
+    return RowKind::Ok;
+}
+
+/* Parsed slice of the file: rows plus malformed line numbers (relative to the chunk) */
+struct CSVChunk {
+    vector<Process> ps;
+    vector<long long> bad;
+    long long lines = 0;
+};
+
+// Parses [b, e), which starts at a line boundary. `firstChunk` enables header
+// detection on its first non-empty line.
+static CSVChunk parseCSVChunk(const char* b, const char* e, bool firstChunk) {
+    CSVChunk c;
+    bool first = firstChunk;
+    Process p;
+    while (b < e) {
+        const char* eol = static_cast<const char*>(memchr(b, '\n', e - b));
+        if (!eol) eol = e;
+        c.lines++;
+        RowKind k = parseCSVRow(b, eol, first, p);
+        b = eol + 1;
+        if (k == RowKind::Blank) continue;
+        first = false;
+        if (k == RowKind::Bad) c.bad.push_back(c.lines);
+        else if (k == RowKind::Ok) c.ps.push_back(move(p));
+    }
+    return c;
+}
+
+/* Optional CSV loader: id,arrival,burst,priority[,deadline[,tickets]]  (header optional)
+   Rows come back in file order; makeTable sorts them.
+   The file is mmapped and, with threads > 1, split on line boundaries and parsed
+   in parallel. Malformed rows are skipped and reported with their line numbers. */
+static vector<Process> loadCSV(const string& filename, int threads = 1) {
+    MappedFile mf(filename);
+    const char* begin = mf.data;
+    const char* end = mf.data + mf.size;
+
+    // small files aren't worth a thread each
+    const size_t minChunk = 1 << 20;
+    size_t nChunks = max<size_t>(1, min<size_t>(threads, mf.size / minChunk));
+    vector<const char*> cut{begin};
+    for (size_t k=1; k<nChunks; k++) {
+        const char* c = begin + mf.size * k / nChunks;
+        if (c <= cut.back()) continue;
+        const char* nl = static_cast<const char*>(memchr(c, '\n', end - c));
+        if (!nl) break;
+        cut.push_back(nl + 1);
+    }
+    cut.push_back(end);
+
+    vector<CSVChunk> chunks(cut.size() - 1);
+    vector<thread> pool;
+    for (size_t k=1; k<chunks.size(); k++)
+        pool.emplace_back([&, k]{ chunks[k] = parseCSVChunk(cut[k], cut[k+1], false); });
+    chunks[0] = parseCSVChunk(cut[0], cut[1], true);
+    for (auto &th : pool) th.join();
+
+    vector<Process> ps;
+    size_t total = 0;
+    for (auto &c : chunks) total += c.ps.size();
+    ps.reserve(total);
+    long long lineBase = 0, nbad = 0;
+    for (auto &c : chunks) {
+        for (long long ln : c.bad) {
+            if (nbad++ < 10) cerr << filename << ":" << lineBase + ln << ": malformed row skipped\n";
+        }
+        lineBase += c.lines;
+        move(c.ps.begin(), c.ps.end(), back_inserter(ps));
+    }
+    if (nbad > 10) cerr << filename << ": " << nbad << " malformed rows skipped in total\n";
+    if (ps.empty()) throw runtime_error("No processes parsed from " + filename);
+    return ps;
+}
+
+/* ---------- Binary workload format ----------
+   Little-endian file: WorkloadHeader, then 8-byte aligned sections
+     arrival[n], burst[n], priority[n], deadline[n], tickets[n], id[n]   (int32 / uint32)
+     id_offsets[m+1] (uint64) and id_blob[ids_bytes]                       (interned id strings)
+   This is ProcTable's layout on disk: rows sorted by (arrival, id) and id[k] is
+   the rank of the row's name, so loading only maps the file. */
+static const char kWorkloadMagic[8] = {'S','C','H','E','D','W','K','1'};
+static const uint32_t kWorkloadVersion = 2; // v2: ids are name ranks
+
+struct WorkloadHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;          // reserved
+    uint64_t count;          // n processes
+    uint64_t id_count;       // m distinct ids
+    uint64_t ids_bytes;
+    uint64_t off_arrival, off_burst, off_priority, off_deadline, off_tickets, off_id;
+    uint64_t off_id_offsets, off_id_blob;
+};
+
+static bool isBinaryWorkload(const string& filename) {
+    ifstream f(filename, ios::binary);
+    char m[8] = {};
+    return f.read(m, 8) && memcmp(m, kWorkloadMagic, 8) == 0;
+}
+
+static void writeBinaryWorkload(const ProcTable& T, const string& filename) {
+    const uint64_t n = T.n;
+    WorkloadHeader h{};
+    memcpy(h.magic, kWorkloadMagic, 8);
+    h.version = kWorkloadVersion;
+    h.count = n;
+    h.id_count = T.idCount;
+    const uint64_t* nameOff = T.nameOff;
+    const char* nameBlob = T.nameBlob;
+    vector<uint64_t> offs;
+    vector<char> blob;
+    if (T.nameDigits) {         // generated names are spelled out on disk
+        offs.reserve(T.idCount + 1);
+        blob.reserve(T.idCount * (T.nameDigits + 1));
+        offs.push_back(0);
+        for (size_t k=0; k<T.n; k++) {
+            string_view v = T.name(k);
+            blob.insert(blob.end(), v.begin(), v.end());
+            offs.push_back(blob.size());
+        }
+        nameOff = offs.data(); nameBlob = blob.data();
+    }
+    h.ids_bytes = nameOff[T.idCount];
+    uint64_t off = sizeof(WorkloadHeader);
+    auto section = [&](uint64_t bytes){ uint64_t at = off; off = (off + bytes + 7) & ~7ULL; return at; };
+    h.off_arrival    = section(4*n);
+    h.off_burst      = section(4*n);
+    h.off_priority   = section(4*n);
+    h.off_deadline   = section(4*n);
+    h.off_tickets    = section(4*n);
+    h.off_id         = section(4*n);
+    h.off_id_offsets = section(8*(h.id_count+1));
+    h.off_id_blob    = section(h.ids_bytes);
+
+    ofstream f(filename, ios::binary);
+    if (!f) throw runtime_error("Failed to open output file: " + filename);
+    uint64_t pos = 0;
+    auto put = [&](uint64_t at, const void* p, size_t bytes){
+        static const char zero[8] = {};
+        f.write(zero, at - pos);                 // alignment padding
+        f.write(static_cast<const char*>(p), bytes);
+        pos = at + bytes;
+    };
+    put(0, &h, sizeof h);
+    put(h.off_arrival, T.arrival, 4*n);
+    put(h.off_burst, T.burst, 4*n);
+    put(h.off_priority, T.priority, 4*n);
+    put(h.off_deadline, T.deadline, 4*n);
+    put(h.off_tickets, T.tickets, 4*n);
+    put(h.off_id, T.id, 4*n);
+    put(h.off_id_offsets, nameOff, 8*(h.id_count+1));
+    put(h.off_id_blob, nameBlob, h.ids_bytes);
+    if (!f) throw runtime_error("Failed to write " + filename);
+}
+
+static ProcTable loadBinaryWorkload(const string& filename) {
+    auto mf = make_shared<MappedFile>(filename);
+    auto bad = [&](const char* why){ return runtime_error(filename + ": bad workload file (" + why + ")"); };
+    if (mf->size < sizeof(WorkloadHeader)) throw bad("truncated header");
+    WorkloadHeader h;
+    memcpy(&h, mf->data, sizeof h);
+    if (memcmp(h.magic, kWorkloadMagic, 8) != 0) throw bad("magic");
+    if (h.version != kWorkloadVersion) throw bad("version; re-run --convert");
+    const uint64_t n = h.count, size = mf->size;
+    auto fits = [&](uint64_t at, uint64_t bytes){ return at % 8 == 0 && at <= size && bytes <= size - at; };
+    for (uint64_t at : {h.off_arrival, h.off_burst, h.off_priority, h.off_deadline, h.off_tickets, h.off_id})
+        if (n > size / 4 || !fits(at, 4*n)) throw bad("column out of range");
+    if (h.id_count >= size / 8 || !fits(h.off_id_offsets, 8*(h.id_count+1)) || !fits(h.off_id_blob, h.ids_bytes))
+        throw bad("id table out of range");
+
+    ProcTable T;
+    auto col = [&](uint64_t at){ return reinterpret_cast<const int32_t*>(mf->data + at); };
+    T.n = n;
+    T.idCount = h.id_count;
+    T.arrival = col(h.off_arrival); T.burst = col(h.off_burst); T.priority = col(h.off_priority);
+    T.deadline = col(h.off_deadline); T.tickets = col(h.off_tickets);
+    T.id = reinterpret_cast<const uint32_t*>(mf->data + h.off_id);
+    T.nameOff = reinterpret_cast<const uint64_t*>(mf->data + h.off_id_offsets);
+    T.nameBlob = mf->data + h.off_id_blob;
+    T.mapping = mf;
+
+    // one linear pass so engines and name() can trust the file
+    if (T.nameOff[0] != 0 || T.nameOff[h.id_count] != h.ids_bytes) throw bad("id offsets");
+    for (uint64_t r=0; r<h.id_count; r++)
+        if (T.nameOff[r] > T.nameOff[r+1]) throw bad("id offsets");
+    for (uint64_t k=0; k<n; k++) {
+        if (T.id[k] >= h.id_count) throw bad("id index");
+        if (T.arrival[k] < 0 || T.burst[k] < 0) throw bad("negative arrival or burst");
+        if (T.priority[k] > kMaxPriority) throw bad("priority above 9999");
+        if (k && (T.arrival[k] < T.arrival[k-1] || (T.arrival[k] == T.arrival[k-1] && T.id[k] <= T.id[k-1])))
+            throw bad("rows not sorted by (arrival, id)");
+    }
+    if (n == 0) throw runtime_error("No processes in " + filename);
+    return T;
+}
+
+/* Random generator  */
+static vector<Process> generateRandom(int n, unsigned seed=42) {
+    mt19937 rng(seed);
+    uniform_int_distribution<int> A(0, 20), B(1, 12), P(1, 4);
+    vector<Process> ps;
+    for (int i=1;i<=n;i++) {
+        int a=A(rng), b=B(rng), p=P(rng);
+        ps.push_back({"P"+to_string(i), a, b, p});
+    }
+    return ps;
+}
+
+/* ---------- Synthetic workload generator ----------
+   Every random value is a pure function of (seed, job, stream) through a
+   Philox4x32-10 counter-based generator, so chunks of jobs are generated
+   independently on a thread pool and the table is bit-identical for any thread
+   count. Arrivals are a Poisson process, or a two-state MMPP that switches
+   between a busy and a quiet rate; bursts are uniform, Pareto or lognormal
+   with mean kGenMeanBurst. The arrival rate is set so the offered load
+   (rate * mean burst / cpus) equals --load. */
+struct GenOptions {
+    string arrivals = "poisson";      // poisson | mmpp
+    string bursts = "uniform";        // uniform | pareto | lognormal
+    double load = 0.9;
+    int cpus = 1;
+};
+
+static array<uint32_t,4> philox4x32(array<uint32_t,4> c, array<uint32_t,2> k) {
+    for (int r=0; r<10; r++) {
+        uint64_t p0 = 0xD2511F53ULL * c[0], p1 = 0xCD9E8D57ULL * c[2];
+        c = {uint32_t(p1 >> 32) ^ c[1] ^ k[0], uint32_t(p1), uint32_t(p0 >> 32) ^ c[3] ^ k[1], uint32_t(p0)};
+        k[0] += 0x9E3779B9; k[1] += 0xBB67AE85;
+    }
+    return c;
+}
+static double unit(uint32_t x) { return (x + 0.5) * (1.0 / 4294967296.0); }   // (0,1)
+
+static constexpr double kGenMeanBurst = 10;
+static constexpr size_t kGenChunk = 1 << 16;   // fixed, so output is independent of threads
+static constexpr int kGenFrac = 20;            // arrivals accumulate in 2^-20 tick fixed point
+
+// Per-chunk job sampler. A chunk restarts the MMPP chain from its stationary
+// distribution, which is seeded per chunk, so chunks need no sequential state.
+class JobSampler {
+    static constexpr double kBusyGap = 2.0/9, kQuietGap = 16.0/9;   // half the jobs each: mean 1
+    static constexpr uint32_t kSwitch = (1u << 24) / 256;          // p = 1/256 per job
+    enum Burst { Uniform, Pareto, Lognormal };
+    array<uint32_t,2> key;
+    double meanGap;
+    bool mmpp, busy = false;
+    Burst kind;
+public:
+    JobSampler(const GenOptions& g, unsigned seed)
+        : key{seed, 0x5EEDF00Du}, meanGap(kGenMeanBurst / (g.load * g.cpus)), mmpp(g.arrivals == "mmpp"),
+          kind(g.bursts == "pareto" ? Pareto : g.bursts == "lognormal" ? Lognormal : Uniform) {}
+    void startChunk(size_t c) {
+        busy = philox4x32({uint32_t(c), uint32_t(c >> 32), 1, 0}, key)[0] & 1;
+    }
+    // job j's gap in fixed point; its burst and priority too when asked for
+    uint64_t next(size_t j, int32_t* burst, int32_t* prio) {
+        auto u = philox4x32({uint32_t(j), uint32_t(j >> 32), 0, 0}, key);
+        double gap = -log(unit(u[0])) * meanGap;
+        if (mmpp) {
+            gap *= busy ? kBusyGap : kQuietGap;
+            if ((u[3] & 0xFFFFFF) < kSwitch) busy = !busy;
+        }
+        if (burst) {
+            double b;
+            if (kind == Pareto) {               // alpha 1.5: finite mean, infinite variance
+                const double alpha = 1.5, xm = (kGenMeanBurst - 0.5) * (alpha - 1) / alpha;   // ceil adds ~0.5
+                b = ceil(xm / pow(unit(u[1]), 1 / alpha));
+            } else if (kind == Lognormal) {     // sigma 1, Box-Muller normal
+                const double sigma = 1.0, mu = log(kGenMeanBurst) - sigma * sigma / 2;
+                double z = sqrt(-2 * log(unit(u[1]))) * cos(2 * M_PI * unit(u[2]));
+                b = round(exp(mu + sigma * z));
+            } else {
+                b = 1 + ((uint64_t)u[1] * 19 >> 32);   // 1..19
+            }
+            *burst = (int32_t)min(max(b, 1.0), (double)(1 << 24));
+            *prio = 1 + (u[3] >> 30);
+        }
+        return (uint64_t)(gap * (1 << kGenFrac));
+    }
+};
+
+// Two passes over fixed chunks: chunk arrival spans, a sequential prefix over
+// them, then each chunk regenerates its jobs from its starting time.
+static ProcTable generateWorkload(size_t n, const GenOptions& g, unsigned seed, int threads) {
+    if (g.arrivals != "poisson" && g.arrivals != "mmpp") throw runtime_error("Unknown --arrivals: " + g.arrivals);
+    if (g.bursts != "uniform" && g.bursts != "pareto" && g.bursts != "lognormal")
+        throw runtime_error("Unknown --bursts: " + g.bursts);
+    if (!(g.load > 0)) throw runtime_error("--load must be positive");
+    if (n == 0 || n > UINT32_MAX) throw runtime_error("Bad workload size");
+
+    ProcTable T;
+    const size_t chunks = (n + kGenChunk - 1) / kGenChunk;
+    vector<uint64_t> start(chunks + 1, 0);
+    for (int c : {0, 1, 2}) T.cols[c].resize(n);
+    T.cols[3].assign(n, -1);          // no deadlines or tickets: both columns share it
+    T.ids.resize(n);
+
+    auto parallel = [&](auto body) {
+        atomic<size_t> nextChunk{0};
+        auto work = [&]{ for (size_t c; (c = nextChunk++) < chunks; ) body(c); };
+        vector<thread> pool;
+        for (int k=1; k<min<int>(threads, chunks); k++) pool.emplace_back(work);
+        work();
+        for (auto &th : pool) th.join();
+    };
+    parallel([&](size_t c) {
+        JobSampler s(g, seed);
+        s.startChunk(c);
+        uint64_t span = 0;
+        for (size_t j = c * kGenChunk, e = min(n, j + kGenChunk); j < e; j++) span += s.next(j, nullptr, nullptr);
+        start[c+1] = span;
+    });
+    for (size_t c=0; c<chunks; c++) start[c+1] += start[c];
+    if ((start[chunks] >> kGenFrac) > (uint64_t)INT_MAX)
+        throw runtime_error("Generated arrivals overflow the clock; raise --load or lower N");
+    vector<uint64_t> work(chunks);
+    parallel([&](size_t c) {
+        JobSampler s(g, seed);
+        s.startChunk(c);
+        uint64_t at = start[c];
+        for (size_t j = c * kGenChunk, e = min(n, j + kGenChunk); j < e; j++) {
+            at += s.next(j, &T.cols[1][j], &T.cols[2][j]);
+            T.cols[0][j] = at >> kGenFrac;
+            T.ids[j] = j;
+            work[c] += T.cols[1][j];
+        }
+    });
+    // no schedule can finish later than the last arrival plus all the work
+    if ((start[chunks] >> kGenFrac) + accumulate(work.begin(), work.end(), 0ULL) > (uint64_t)INT_MAX)
+        throw runtime_error("Generated workload may overflow the clock; raise --load or lower N");
+
+    // arrivals never decrease and ids count up, so rows are already in (arrival, id) order
+    T.n = n;
+    T.idCount = n;
+    T.nameDigits = to_string(n).size();
+    T.arrival = T.cols[0].data(); T.burst = T.cols[1].data(); T.priority = T.cols[2].data();
+    T.deadline = T.tickets = T.cols[3].data();
+    T.id = T.ids.data();
+    return T;
+}
+
+
+/* ---------- Per-run scratch storage ----------
+   The event loops must not touch malloc once a run is set up. Ready queues are
+   rings and heaps sized to the table, node-based sets draw from a per-run arena,
+   and every operator new bumps a per-thread counter so --count-allocs can show
+   what is left. */
+static thread_local uint64_t tAllocs = 0;
+
+void* operator new(size_t sz) {
+    tAllocs++;
+    if (void* p = malloc(sz ? sz : 1)) return p;
+    throw bad_alloc();
+}
+// GCC pairs the inlined free() with new-expressions and warns; the pairing is ours.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+#pragma GCC diagnostic pop
+
+// Bump arena with per-size free lists, sized once for a run's node containers.
+// Requests past the estimate fall back to operator new.
+class Arena {
+    static constexpr size_t kAlign = 16, kClasses = 16;
+    unique_ptr<char[]> buf;
+    size_t cap = 0, used = 0;
+    void* freeList[kClasses] = {};
+    bool owns(void* p) const { return p >= buf.get() && p < buf.get() + cap; }
+public:
+    explicit Arena(size_t bytes): buf(new char[bytes]), cap(bytes) {}
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    void* get(size_t sz) {
+        sz = (sz + kAlign - 1) & ~(kAlign - 1);
+        size_t c = sz / kAlign;
+        if (c < kClasses && freeList[c]) { void* p = freeList[c]; freeList[c] = *(void**)p; return p; }
+        if (c < kClasses && used + sz <= cap) { void* p = buf.get() + used; used += sz; return p; }
+        return ::operator new(sz);
+    }
+    void put(void* p, size_t sz) {
+        size_t c = ((sz + kAlign - 1) & ~(kAlign - 1)) / kAlign;
+        if (!owns(p)) { ::operator delete(p); return; }
+        *(void**)p = freeList[c]; freeList[c] = p;
+    }
+};
+
+template <class T>
+struct ArenaAlloc {
+    using value_type = T;
+    Arena* arena;
+    explicit ArenaAlloc(Arena& a): arena(&a) {}
+    template <class U> ArenaAlloc(const ArenaAlloc<U>& o): arena(o.arena) {}
+    T* allocate(size_t n) { return static_cast<T*>(arena->get(n * sizeof(T))); }
+    void deallocate(T* p, size_t n) { arena->put(p, n * sizeof(T)); }
+    template <class U> bool operator==(const ArenaAlloc<U>& o) const { return arena == o.arena; }
+    template <class U> bool operator!=(const ArenaAlloc<U>& o) const { return arena != o.arena; }
+};
+template <class T> using ArenaSet = set<T, less<T>, ArenaAlloc<T>>;
+static constexpr size_t kSetNodeBytes = 64;   // one rb-tree node of a small key, rounded up
+
+// FIFO of table rows on a fixed ring. A job waits in at most one queue at a
+// time, so a capacity of n never overflows.
+class RingQueue {
+    vector<int> buf;
+    size_t head = 0, count = 0;
+    size_t at(size_t i) const { i += head; return i >= buf.size() ? i - buf.size() : i; }
+public:
+    explicit RingQueue(size_t cap = 0): buf(max<size_t>(cap, 1)) {}
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+    int front() const { return buf[head]; }
+    int back() const { return buf[at(count - 1)]; }
+    void push(int k) { buf[at(count)] = k; count++; }
+    void pop() { if (++head == buf.size()) head = 0; count--; }
+    void pop_back() { count--; }
+    void save(SnapWriter& w) const {
+        w.val<uint64_t>(count);
+        for (size_t i=0; i<count; i++) w.val<int>(buf[at(i)]);
+    }
+    void load(SnapReader& r) {
+        head = count = 0;
+        for (uint64_t i = r.val<uint64_t>(); i > 0; i--) push(r.val<int>());
+    }
+};
+
+template <class T> using MinHeap = priority_queue<T, vector<T>, greater<>>;
+template <class T> static MinHeap<T> reservedHeap(size_t n) {
+    vector<T> v;
+    v.reserve(n);
+    return MinHeap<T>(greater<>(), move(v));
+}
+// a heap's array, for snapshots: saved and restored as is, so it stays a heap
+template <class T> static vector<T>& heapItems(MinHeap<T>& h) {
+    struct Access : MinHeap<T> { static vector<T>& of(MinHeap<T>& h) { return h.*(&Access::c); } };
+    return Access::of(h);
+}
+template <class T> static const vector<T>& heapItems(const MinHeap<T>& h) {
+    return heapItems(const_cast<MinHeap<T>&>(h));
+}
+
+/* ---------- Ready-set arg-min (SIMD with scalar fallback) ----------
+   Finds the position of the smallest (key, row) pair in two parallel int32
+   arrays. Rows are sorted by (arrival, id rank), so the row is the (arrival, id)
+   tie-break. The tail past the last full vector is scanned scalar. */
+using ArgMinFn = int (*)(const int32_t*, const int32_t*, int);
+
+static inline bool keyRowLess(int32_t ka, int32_t ra, int32_t kb, int32_t rb) {
+    return ka < kb || (ka == kb && ra < rb);
+}
+
+static int argminScalar(const int32_t* key, const int32_t* row, int n) {
+    int best = 0;
+    for (int i=1; i<n; i++)
+        if (keyRowLess(key[i], row[i], key[best], row[best])) best = i;
+    return best;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// Three short passes instead of one blend-heavy loop: the minimum key, the
+// minimum row among entries with that key, then the position of that row (rows
+// are unique). Each pass is a min or compare per vector with no lane dependency
+// beyond the accumulator.
+__attribute__((target("sse4.1"))) static inline __m128i ld4(const int32_t* p) {
+    return _mm_loadu_si128((const __m128i*)p);
+}
+__attribute__((target("sse4.1"))) static inline int32_t hmin4(__m128i v) {
+    v = _mm_min_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_min_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(v);
+}
+__attribute__((target("avx2"))) static inline __m256i ld8(const int32_t* p) {
+    return _mm256_loadu_si256((const __m256i*)p);
+}
+__attribute__((target("avx2"))) static inline int32_t hmin8(__m256i v) {
+    return hmin4(_mm_min_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1)));
+}
+
+__attribute__((target("sse4.1")))
+static int argminSSE41(const int32_t* key, const int32_t* row, int n) {
+    if (n < 8) return argminScalar(key, row, n);
+    int i;
+    __m128i m0 = ld4(key), m1 = m0;
+    for (i = 4; i+8 <= n; i += 8) { m0 = _mm_min_epi32(m0, ld4(key+i)); m1 = _mm_min_epi32(m1, ld4(key+i+4)); }
+    int32_t mk = hmin4(_mm_min_epi32(m0, m1));
+    for (; i<n; i++) mk = min(mk, key[i]);
+
+    const __m128i vk = _mm_set1_epi32(mk), big = _mm_set1_epi32(INT32_MAX);
+    __m128i r0 = big;
+    for (i = 0; i+4 <= n; i += 4)
+        r0 = _mm_min_epi32(r0, _mm_blendv_epi8(big, ld4(row+i), _mm_cmpeq_epi32(ld4(key+i), vk)));
+    int32_t mr = hmin4(r0);
+    for (; i<n; i++) if (key[i] == mk) mr = min(mr, row[i]);
+
+    const __m128i vr = _mm_set1_epi32(mr);
+    for (i = 0; i+4 <= n; i += 4)
+        if (int m = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(ld4(row+i), vr)))) return i + __builtin_ctz(m);
+    for (; i<n; i++) if (row[i] == mr) break;
+    return i;
+}
+
+__attribute__((target("avx2")))
+static int argminAVX2(const int32_t* key, const int32_t* row, int n) {
+    if (n < 16) return argminScalar(key, row, n);
+    int i;
+    __m256i m0 = ld8(key), m1 = m0;
+    for (i = 8; i+16 <= n; i += 16) { m0 = _mm256_min_epi32(m0, ld8(key+i)); m1 = _mm256_min_epi32(m1, ld8(key+i+8)); }
+    int32_t mk = hmin8(_mm256_min_epi32(m0, m1));
+    for (; i<n; i++) mk = min(mk, key[i]);
+
+    const __m256i vk = _mm256_set1_epi32(mk), big = _mm256_set1_epi32(INT32_MAX);
+    __m256i r0 = big;
+    for (i = 0; i+8 <= n; i += 8)
+        r0 = _mm256_min_epi32(r0, _mm256_blendv_epi8(big, ld8(row+i), _mm256_cmpeq_epi32(ld8(key+i), vk)));
+    int32_t mr = hmin8(r0);
+    for (; i<n; i++) if (key[i] == mk) mr = min(mr, row[i]);
+
+    const __m256i vr = _mm256_set1_epi32(mr);
+    for (i = 0; i+8 <= n; i += 8)
+        if (int m = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(ld8(row+i), vr)))) return i + __builtin_ctz(m);
+    for (; i<n; i++) if (row[i] == mr) break;
+    return i;
+}
+#endif
+
+// kernels this CPU can run, best last; SCHED_ARGMIN=scalar|sse4.1|avx2 caps the choice
+static vector<pair<string, ArgMinFn>> argminKernels() {
+    vector<pair<string, ArgMinFn>> ks = {{"scalar", argminScalar}};
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.1")) ks.push_back({"sse4.1", argminSSE41});
+    if (__builtin_cpu_supports("avx2"))   ks.push_back({"avx2", argminAVX2});
+#endif
+    return ks;
+}
+
+static ArgMinFn bestArgMin() {
+    auto ks = argminKernels();
+    if (const char* cap = getenv("SCHED_ARGMIN"))
+        while (ks.size() > 1 && ks.back().first != cap) ks.pop_back();
+    return ks.back().second;
+}
+
+// resolved at startup so the first call from an event loop does no setup work
+static const ArgMinFn argminBest = bestArgMin();
+
+static int argminKeyRow(const int32_t* key, const int32_t* row, int n) {
+    return argminBest(key, row, n);
+}
+
+/* Ready sets for the preemptive SRTF/EDF engines: both return the smallest
+   (key, row) and let the engine re-key the job it just ran. The heap is
+   O(log n) per decision; the scan set is O(n) but branch-free and contiguous,
+   and re-keying is a single store, which wins for ready sets of a few thousand. */
+struct HeapReadySet {
+    static constexpr const char* tag = "";
+    MinHeap<pair<int,int>> q;
+    void reserve(size_t n) { q = reservedHeap<pair<int,int>>(n); }
+    bool empty() const { return q.empty(); }
+    size_t size() const { return q.size(); }
+    void push(int key, int row) { q.push({key, row}); }
+    int top() const { return q.top().second; }
+    void pop() { q.pop(); }
+    void rekeyTop(int key) { int r = q.top().second; q.pop(); q.push({key, r}); }
+    void save(SnapWriter& w) const { w.items(heapItems(q)); }
+    void load(SnapReader& r) { r.items(heapItems(q)); }
+};
+
+struct ScanReadySet {
+    static constexpr const char* tag = " (scan)";
+    vector<int32_t> key, row;         // dense; removal swaps in the last entry
+    int at = -1;                      // position found by the last top()
+    void reserve(size_t n) { key.reserve(n); row.reserve(n); }
+    bool empty() const { return key.empty(); }
+    size_t size() const { return key.size(); }
+    void push(int k, int r) { key.push_back(k); row.push_back(r); }
+    int top() { at = argminKeyRow(key.data(), row.data(), key.size()); return row[at]; }
+    void pop() { key[at] = key.back(); row[at] = row.back(); key.pop_back(); row.pop_back(); }
+    void rekeyTop(int k) { key[at] = k; }
+    void save(SnapWriter& w) const { w.items(key); w.items(row); w.val(at); }
+    void load(SnapReader& r) { r.items(key); r.items(row); r.val(at); }
+};
+
+/* ---------- Run statistics (--stats, --perf) ----------
+   Opt-in counters that explain where an engine spends its time. Engines only
+   touch them through SimResult::stats, which is null unless asked for, so a
+   plain run pays one pointer test per decision. */
+struct SchedStats {
+    long long dispatches = 0;
+    long long switches = 0;          // dispatches of a different job than the one that ran last
+    long long idleJumps = 0;         // clock advances with nothing running
+    long long promotions = 0;        // aging moves (priority buckets, MLFQ levels)
+    LatencyHistogram readyLen;       // jobs ready at each decision, the picked one included
+    double loadMs = 0, sortMs = 0, simulateMs = 0, outputMs = 0;
+    // hardware counters around run(), when --perf could open them
+    bool perf = false;
+    string perfError;
+    uint64_t cycles = 0, instructions = 0, cacheMisses = 0;
+};
+
+static double msSince(chrono::steady_clock::time_point t0) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+}
+
+// cycles, instructions and cache misses of this thread as one perf_event group
+class PerfCounters {
+    int fd[3] = {-1, -1, -1};
+    string err;
+public:
+    PerfCounters() {
+        const uint64_t cfg[3] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES};
+        for (int k=0; k<3; k++) {
+            perf_event_attr a{};
+            a.size = sizeof a;
+            a.type = PERF_TYPE_HARDWARE;
+            a.config = cfg[k];
+            a.disabled = k == 0;
+            a.exclude_kernel = 1;
+            a.exclude_hv = 1;
+            a.read_format = PERF_FORMAT_GROUP;
+            fd[k] = syscall(__NR_perf_event_open, &a, 0, -1, k ? fd[0] : -1, 0);
+            if (fd[k] < 0) { err = string("perf_event_open: ") + strerror(errno); return; }
+        }
+    }
+    ~PerfCounters() { for (int f : fd) if (f >= 0) close(f); }
+    bool ok() const { return err.empty(); }
+    const string& error() const { return err; }
+    void start() {
+        if (!ok()) return;
+        ioctl(fd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+    void stop(SchedStats& st) {
+        if (!ok()) { st.perfError = err; return; }
+        ioctl(fd[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        uint64_t v[4] = {};         // nr, then one value per counter
+        if (read(fd[0], v, sizeof v) != (ssize_t)sizeof v) { st.perfError = "perf read failed"; return; }
+        st.perf = true;
+        st.cycles = v[1]; st.instructions = v[2]; st.cacheMisses = v[3];
+    }
+};
+
+// the engine counters are only filled when --stats hands the engine a SchedStats,
+// so --perf alone prints just the hardware block
+static void printStats(const SchedStats& s, bool engine) {
+    if (engine) {
+        LatencySummary q = s.readyLen.summary();
+        cout << "Dispatches: " << s.dispatches << ", context switches: " << s.switches
+             << ", idle jumps: " << s.idleJumps << ", aging promotions: " << s.promotions << "\n";
+        cout << "Ready queue mean/p50/p90/p99/max: " << q.mean << "/" << q.p50 << "/" << q.p90
+             << "/" << q.p99 << "/" << q.max << "\n";
+        cout << "Phases (ms) load/sort/simulate/output: " << s.loadMs << "/" << s.sortMs << "/"
+             << s.simulateMs << "/" << s.outputMs << "\n";
+    }
+    if (s.perf)
+        cout << "Cycles: " << s.cycles << ", instructions: " << s.instructions << " (IPC "
+             << (s.cycles ? (double)s.instructions / s.cycles : 0.0) << "), cache misses: " << s.cacheMisses << "\n";
+    else if (!s.perfError.empty())
+        cout << "Hardware counters unavailable (" << s.perfError << ")\n";
+}
+
+/* ---------- Trace output ----------
+   Engines append fixed 16-byte records to one of a ring of large buffers; a
+   background thread writes full buffers out, so the event loop does no I/O or
+   formatting. It only waits when every buffer is queued, i.e. when the disk
+   cannot keep up. A file ending in .bin gets a magic header followed by the
+   raw records, whose rows index the (arrival, id)-sorted workload (the
+   --convert order). Any other file gets CSV with names spelled out:
+     S,cpu,id,end                      one Gantt segment, ending at `end`
+     R,cpu,id,completion,arrival,burst,waiting,turnaround,response   one job */
+struct TraceRec {
+    uint16_t kind, cpu;          // kind: 0 segment, 1 result
+    uint32_t row;
+    int32_t time, resp;          // segment end / completion; response for results
+};
+static const char kTraceMagic[8] = {'S','C','H','E','D','T','R','1'};
+
+class TraceWriter {
+    static constexpr size_t kRecs = 1 << 16, kBuffers = 4;   // 1 MiB per buffer
+    const ProcTable& ps;
+    ofstream f;
+    bool binary;
+    vector<TraceRec> buf[kBuffers];
+    size_t fill = 0, queued = 0, wr = 0;   // buffers fill-queued .. fill-1 wait for the writer
+    bool closing = false;
+    mutex m;
+    condition_variable cv;
+    thread th;
+
+    void put(const TraceRec& r) {
+        buf[fill].push_back(r);
+        if (buf[fill].size() == kRecs) handOff();
+    }
+    void handOff() {
+        unique_lock<mutex> lk(m);
+        queued++;
+        cv.notify_all();
+        cv.wait(lk, [&]{ return queued < kBuffers; });
+        fill = (fill + 1) % kBuffers;
+    }
+    void writeOut(const vector<TraceRec>& recs) {
+        if (binary) { f.write(reinterpret_cast<const char*>(recs.data()), recs.size() * sizeof(TraceRec)); return; }
+        string s;
+        s.reserve(recs.size() * 48);
+        char num[16];
+        auto field = [&](long long v) { s += ','; s.append(num, to_chars(num, num + 16, v).ptr); };
+        for (auto &r : recs) {
+            s += r.kind ? 'R' : 'S';
+            field(r.cpu);
+            s += ','; s += ps.name(r.row);
+            field(r.time);
+            if (r.kind) {
+                int turn = r.time - ps.arrival[r.row];
+                field(ps.arrival[r.row]); field(ps.burst[r.row]);
+                field(turn - ps.burst[r.row]); field(turn); field(r.resp);
+            }
+            s += '\n';
+        }
+        f.write(s.data(), s.size());
+    }
+    void loop() {
+        unique_lock<mutex> lk(m);
+        while (true) {
+            cv.wait(lk, [&]{ return queued > 0 || closing; });
+            if (queued == 0) return;
+            lk.unlock();
+            writeOut(buf[wr]);
+            buf[wr].clear();
+            wr = (wr + 1) % kBuffers;
+            lk.lock();
+            queued--;
+            cv.notify_all();
+        }
+    }
+public:
+    TraceWriter(const ProcTable& ps, const string& file)
+        : ps(ps), f(file, ios::binary), binary(file.size() >= 4 && file.compare(file.size()-4, 4, ".bin") == 0) {
+        if (!f) throw runtime_error("Failed to open trace output: " + file);
+        if (binary) f.write(kTraceMagic, 8);
+        else f << "record,cpu,id,time,arrival,burst,waiting,turnaround,response\n";
+        for (auto &b : buf) b.reserve(kRecs);
+        th = thread([this]{ loop(); });
+    }
+    ~TraceWriter() { if (th.joinable()) try { close(); } catch (...) {} }
+    void segment(int cpu, int row, int end) { put({0, (uint16_t)cpu, (uint32_t)row, end, 0}); }
+    void result(int cpu, int row, int completion, int resp) { put({1, (uint16_t)cpu, (uint32_t)row, completion, resp}); }
+    // flush what is buffered and stop the writer thread
+    void close() {
+        {
+            lock_guard<mutex> lk(m);
+            if (!buf[fill].empty()) queued++;
+            closing = true;
+        }
+        cv.notify_all();
+        th.join();
+        f.flush();
+        if (!f) throw runtime_error("Failed to write trace output");
+    }
+};
+
+/* ---------- Checkpoints (--checkpoint-at, --resume) ----------
+   A snapshot is the single-CPU engine's whole state just before the first event
+   at or after a chosen time B: clock, pending events, per-row results and
+   remaining work, the metrics so far and the policy's queues (MLFQ levels, CFS
+   vruntimes, lottery generator, ...). By then rows [0, cut) have arrived and no
+   others, so the snapshot also holds for any other workload whose first `cut`
+   rows are identical and whose next arrival is not before B: a run of that
+   workload would reach the same state. --resume picks the latest snapshot that
+   holds for the new workload and simulates only from there on.
+   File: magic, then one record per snapshot: CheckpointHeader, scheduler name,
+   payload. Records are sized, so a resume reads only the one it uses. */
+static const char kCheckpointMagic[8] = {'S','C','H','E','D','C','K','1'};
+
+struct CheckpointHeader {
+    uint64_t bytes;          // payload size
+    uint64_t cut;            // rows arrived
+    uint64_t finished;       // rows completed
+    uint64_t prefix;         // rowHash over rows [0, cut)
+    int32_t time;            // B
+    uint32_t nameLen;
+};
+
+struct Snapshot {
+    int time = 0;
+    size_t cut = 0;
+    string scheduler, payload;
+};
+
+// FNV-1a over the columns and name of rows [from, to), continuing from h
+static constexpr uint64_t kFnvBasis = 14695981039346656037ULL;
+static uint64_t rowHash(const ProcTable& ps, size_t from, size_t to, uint64_t h = kFnvBasis) {
+    auto mix = [&](const void* p, size_t bytes) {
+        for (size_t i=0; i<bytes; i++) { h ^= static_cast<const unsigned char*>(p)[i]; h *= 1099511628211ULL; }
+    };
+    for (size_t k=from; k<to; k++) {
+        int32_t v[5] = {ps.arrival[k], ps.burst[k], ps.priority[k], ps.deadline[k], ps.tickets[k]};
+        mix(v, sizeof v);
+        string_view name = ps.name(k);
+        uint32_t len = name.size();
+        mix(&len, sizeof len); mix(name.data(), name.size());
+    }
+    return h;
+}
+
+// Writes the snapshots of one run; the engine asks due() before each event
+class Checkpointer {
+    string file;
+    ofstream f;
+    vector<int> at;                 // requested times, ascending
+    size_t next = 0;
+    uint64_t hash = kFnvBasis;      // rowHash of rows [0, hashed)
+    size_t hashed = 0;
+public:
+    size_t taken = 0;
+    Checkpointer(const string& file, vector<int> times): file(file), f(file, ios::binary), at(move(times)) {
+        if (!f) throw runtime_error("Failed to open checkpoint file: " + file);
+        sort(at.begin(), at.end());
+        f.write(kCheckpointMagic, 8);
+    }
+    bool due(int time) const { return next < at.size() && time >= at[next]; }
+    // one snapshot serves every requested time up to `time`
+    void write(const ProcTable& ps, const string& scheduler, int time, size_t cut, size_t finished,
+               const string& payload) {
+        while (next < at.size() && at[next] <= time) next++;
+        hash = rowHash(ps, hashed, cut, hash);
+        hashed = cut;
+        CheckpointHeader h{payload.size(), cut, finished, hash, time, (uint32_t)scheduler.size()};
+        f.write(reinterpret_cast<const char*>(&h), sizeof h);
+        f << scheduler << payload;
+        f.flush();
+        if (!f) throw runtime_error("Failed to write checkpoint file: " + file);
+        taken++;
+    }
+};
+
+// The latest snapshot in `file` taken by `scheduler` that holds for `ps`; false
+// when none does and the run has to start from t=0
+static bool findSnapshot(const string& file, const ProcTable& ps, const string& scheduler, Snapshot& out) {
+    ifstream f(file, ios::binary);
+    if (!f) throw runtime_error("Failed to open checkpoint file: " + file);
+    char m[8] = {};
+    if (!f.read(m, 8) || memcmp(m, kCheckpointMagic, 8) != 0) throw runtime_error(file + ": not a checkpoint file");
+    uint64_t hash = kFnvBasis;
+    size_t hashed = 0;
+    streamoff best = -1;
+    CheckpointHeader h, bestH{};
+    while (f.read(reinterpret_cast<char*>(&h), sizeof h)) {
+        string name(h.nameLen, '\0');
+        if (!f.read(name.data(), h.nameLen)) break;
+        streamoff at = f.tellg();
+        f.seekg(h.bytes, ios::cur);
+        if (name != scheduler || h.cut > ps.size() || h.finished >= ps.size()) continue;
+        if (h.cut < ps.size() && ps.arrival[h.cut] < h.time) continue;
+        if (h.cut < hashed) { hash = kFnvBasis; hashed = 0; }
+        hash = rowHash(ps, hashed, h.cut, hash);
+        hashed = h.cut;
+        if (hash == h.prefix) { best = at; bestH = h; }
+    }
+    if (best < 0) return false;
+    f.clear();
+    f.seekg(best);
+    out.time = bestH.time;
+    out.cut = bestH.cut;
+    out.scheduler = scheduler;
+    out.payload.resize(bestH.bytes);
+    if (!f.read(out.payload.data(), bestH.bytes)) throw runtime_error(file + ": truncated checkpoint");
+    return true;
+}
+
+/* ---------- Discrete-event core ----------
+   Single-CPU policies are callbacks on one event loop. The loop owns the clock,
+   the CPU and the event list: arrivals (the next row of the table), aging timers
+   set by the policy, and the end of the running slice (quantum expiry or
+   completion). Events at the same instant run in EventType order, and the CPU
+   picks the next job only after the last of them, so a policy sees every arrival
+   and promotion up to `now` before it decides. Time jumps from event to event,
+   so cost follows the number of events, not the number of simulated ticks. */
+enum EventType : uint8_t { EvArrival, EvAging, EvExpiry, EvCompletion };   // same-instant order
+
+struct Event {
+    int time;
+    int job;
+    uint64_t order;      // type << 56 | sequence: FIFO among equal (time, type)
+    EventType type() const { return EventType(order >> 56); }
+    bool operator<(const Event& o) const { return time != o.time ? time < o.time : order < o.order; }
+};
+
+// Brown's calendar queue: a ring of buckets, each `width` ticks wide, scanned one
+// "day" at a time. The ring doubles or halves with the event count and the width
+// is re-estimated from the spacing of the earliest events, so buckets hold O(1)
+// events and push/pop are O(1) amortised. Events live in a node pool and each
+// bucket is a list kept earliest-first; the pool only grows past its high-water
+// mark, so a steady-state run recycles nodes without allocating. push() returns
+// the node so the loop can cancel a slice end that a preemption made moot.
+class CalendarQueue {
+    struct Node { Event e; int next; };
+    vector<Node> node;                          // free nodes are chained from freeHead
+    vector<int> bucket = vector<int>(2, -1);    // list heads, -1 when empty
+    int freeHead = -1;
+    long long width = 1, dayEnd = 1;   // dayEnd: exclusive end of the current bucket's day
+    size_t cur = 0, n = 0;
+
+    static long long floorDiv(long long a, long long b) { return a / b - ((a % b != 0) && ((a < 0) != (b < 0))); }
+    size_t slot(long long time) const { return (size_t)floorDiv(time, width) & (bucket.size() - 1); }
+    void link(int i) {
+        int* p = &bucket[slot(node[i].e.time)];
+        while (*p >= 0 && node[*p].e < node[i].e) p = &node[*p].next;
+        node[i].next = *p; *p = i;
+    }
+    void release(int i) {
+        node[i].next = freeHead; freeHead = i;
+        if (--n < bucket.size() / 4 && bucket.size() > 16) resize(bucket.size() / 2);
+    }
+    void resize(size_t nb) {
+        // chain every event, keeping the 32 earliest times for the width estimate
+        int all = -1;
+        int early[32];
+        size_t k = 0;
+        for (int& h : bucket)
+            while (h >= 0) {
+                int i = h; h = node[i].next;
+                node[i].next = all; all = i;
+                int t = node[i].e.time;
+                if (k == 32 && t >= early[31]) continue;
+                size_t j = k < 32 ? k++ : 31;
+                for (; j > 0 && early[j-1] > t; j--) early[j] = early[j-1];
+                early[j] = t;
+            }
+        if (k > 1 && early[k-1] > early[0])
+            width = max(1LL, 3 * ((long long)early[k-1] - early[0]) / (long long)(k - 1));
+        bucket.assign(nb, -1);
+        while (all >= 0) { int next = node[all].next; link(all); all = next; }
+        if (k) seek(early[0]);
+    }
+    void seek(long long time) { cur = slot(time); dayEnd = (floorDiv(time, width) + 1) * width; }
+    // move cur to the bucket holding the earliest event
+    void locate() {
+        for (size_t i=0; i<bucket.size(); i++) {
+            int h = bucket[cur];
+            if (h >= 0 && node[h].e.time < dayEnd) return;
+            cur = (cur + 1) & (bucket.size() - 1); dayEnd += width;
+        }
+        int best = -1;    // nothing within a year: jump straight to the minimum
+        for (int h : bucket) if (h >= 0 && (best < 0 || node[h].e < node[best].e)) best = h;
+        seek(node[best].e.time);
+    }
+public:
+    explicit CalendarQueue(size_t hint = 64) { node.reserve(hint); bucket.reserve(hint); }
+    bool empty() const { return n == 0; }
+    size_t size() const { return n; }
+    template <class F> void each(F f) const {
+        for (int h : bucket) for (int i = h; i >= 0; i = node[i].next) f(node[i].e);
+    }
+    // forced inline: once snapshots restore events too, GCC stops inlining it into
+    // the event loop, which costs 15-20% on RR
+    __attribute__((always_inline)) int push(const Event& e) {
+        if (n == 0 || e.time < dayEnd - width) seek(e.time);   // before the day top() moved to
+        int i = freeHead;
+        if (i >= 0) { freeHead = node[i].next; node[i].e = e; }
+        else { i = node.size(); node.push_back({e, -1}); }
+        link(i);
+        if (++n > 2 * bucket.size()) resize(2 * bucket.size());
+        return i;
+    }
+    const Event& top() { locate(); return node[bucket[cur]].e; }
+    Event pop() {
+        locate();
+        int i = bucket[cur];
+        Event e = node[i].e;
+        bucket[cur] = node[i].next;
+        release(i);
+        return e;
+    }
+    void cancel(int i) {
+        int* p = &bucket[slot(node[i].e.time)];
+        while (*p != i) p = &node[*p].next;
+        *p = node[i].next;
+        release(i);
+    }
+};
+
+class EventCore {
+    CalendarQueue events;
+    uint64_t seq = 0;
+public:
+    int push(int time, EventType type, int job) {
+        return events.push({time, job, (uint64_t)type << 56 | seq++});
+    }
+    void cancel(int id) { events.cancel(id); }
+    // policies set aging timers; they fire as EventPolicy::timer(job, time)
+    void timer(int time, int job) { push(time, EvAging, job); }
+    bool empty() const { return events.empty(); }
+    const Event& top() { return events.top(); }
+    Event pop() { return events.pop(); }
+    template <class F> void each(F f) const { events.each(f); }
+    // snapshots keep each event's order stamp, so restored events pop exactly as
+    // they would have; load() hands every event to `place`, which may restore()
+    // it (possibly retimed) or drop it
+    void save(SnapWriter& w) const {
+        w.val(seq);
+        w.val<uint64_t>(events.size());
+        events.each([&](const Event& e){ w.val(e); });
+    }
+    template <class F> void load(SnapReader& r, F place) {
+        r.val(seq);
+        for (uint64_t i = r.val<uint64_t>(); i > 0; i--) place(r.val<Event>());
+    }
+    int restore(const Event& e) { return events.push(e); }
+};
+
+// A policy's per-run state and its reactions to events. pick() chooses the job to
+// run; expire()/finish() report the end of its slice (ran ticks) before the next pick.
+class EventPolicy {
+public:
+    virtual ~EventPolicy() = default;
+    virtual void arrive(int k, int now) = 0;
+    virtual int pick(int now) = 0;                           // -1 when nothing is ready
+    virtual int slice(int) const { return INT_MAX; }         // longest run before the next decision
+    virtual bool preemptOnArrival() const { return false; }  // arrivals end the running slice
+    virtual void start(int, int) {}
+    virtual void expire(int, int, int) {}                    // slice over, job still has work
+    virtual void finish(int, int, int) {}                    // job completed
+    virtual void timer(int, int) {}                          // aging timer from EventCore::timer
+    // --stats: jobs waiting for the CPU, and aging moves made so far
+    virtual size_t queued() const = 0;
+    virtual long long promotions() const { return 0; }
+    // checkpoints: state as of the first `cut` rows having arrived. load() runs on
+    // a fresh policy, possibly over a longer table, after the engine has restored
+    // out.remaining and the pending events.
+    virtual void save(SnapWriter&, int cut) const = 0;
+    virtual void load(SnapReader&, int cut) = 0;
+};
+
+// The default engine's loop variables, as saved in a snapshot
+struct LoopState { int t, done, last, cur, since, end; };
+
+// What a run prints and where its schedule goes. The Gantt chart is only kept
+// when it is printed and `gantt` is set; `trace` receives the schedule and
+// per-process results as they happen.
+struct RunOptions {
+    bool print = true;
+    bool gantt = true;
+    TraceWriter* trace = nullptr;
+    SchedStats* stats = nullptr;
+    Checkpointer* checkpoint = nullptr;
+    const Snapshot* resume = nullptr;
+};
+
+class Scheduler {
+public:
+    virtual ~Scheduler() = default;
+    virtual string name() const = 0;
+
+    // Shared engine: ps is sorted by (arrival, id) once when the table is built;
+    // it is only read. Per-process results go into `out`.
+    SimResult run(const ProcTable& ps, RunArrays& out, const RunOptions& opt = {}) {
+        const size_t n = ps.size();
+        out.waiting.assign(n, 0);
+        out.turnaround.assign(n, 0);
+        out.response.assign(n, -1);
+        out.remaining.resize(n);
+        for (size_t k=0; k<n; k++) out.remaining[k] = ps.burst[k];
+        SimResult R;
+        R.keepGantt = opt.print && opt.gantt;
+        R.trace = opt.trace;
+        R.stats = opt.stats;
+        R.checkpoint = opt.checkpoint;
+        R.resume = opt.resume;
+        auto t0 = chrono::steady_clock::now();
+        if (n) simulate(ps, out, R);
+        if (R.stats) { R.stats->simulateMs = msSince(t0); R.stats->dispatches = R.decisions; }
+        R.metrics = R.acc.finish((long long)R.cpus * R.total_time, R.idle, R.total_time);
+        if (!opt.print) return R;
+        t0 = chrono::steady_clock::now();
+        print(ps, out, R);
+        if (R.stats) R.stats->outputMs = msSince(t0);
+        return R;
+    }
+    SimResult run(const ProcTable& ps, const RunOptions& opt = {}) {
+        RunArrays out;
+        return run(ps, out, opt);
+    }
+
+protected:
+    void print(const ProcTable& ps, const RunArrays& out, const SimResult& R) {
+        printMetrics(R.metrics);
+        report(ps, out);
+        if (R.cpu.empty()) { if (R.keepGantt) printGantt(ps, R.gantt); return; }
+        for (size_t c=0; c<R.cpu.size(); c++) {
+            auto &cs = R.cpu[c];
+            cout << "CPU" << c << ": util " << (R.total_time ? 100.0 * cs.busy / R.total_time : 0.0)
+                 << "%, dispatches " << cs.dispatches << ", migrations in " << cs.migrations << "\n";
+        }
+        if (R.keepGantt)
+            for (size_t c=0; c<R.cpu.size(); c++) printGantt(ps, R.cpu[c].gantt, " CPU" + to_string(c));
+    }
+
+    // Implementations must fill out.waiting/out.turnaround and R; out.remaining
+    // starts at each burst_time. The default runs policy() on the event core.
+    virtual void simulate(const ProcTable& ps, RunArrays& out, SimResult& R);
+    // checkpoints of the default engine, see Checkpoints above
+    void checkpoint(const ProcTable& ps, const RunArrays& out, const SimResult& R, const EventCore& core,
+                    const EventPolicy& pol, LoopState s, int b) const;
+    static LoopState resume(const ProcTable& ps, RunArrays& out, SimResult& R, EventCore& core, EventPolicy& pol);
+    // Fresh per-run policy state; `core` is where it sets timers
+    virtual unique_ptr<EventPolicy> policy(const ProcTable&, RunArrays&, EventCore&) const { return nullptr; }
+    // Policy-specific metrics printed after the common ones
+    virtual void report(const ProcTable&, const RunArrays&) {}
+
+    // a slice of job k on `cpu` ended at t
+    static void segment(SimResult& R, int cpu, int k, int t) {
+        if (R.keepGantt) (R.cpu.empty() ? R.gantt : R.cpu[cpu].gantt).push_back({k, t});
+        if (R.trace) R.trace->segment(cpu, k, t);
+    }
+    static void complete(const ProcTable& ps, int k, int t, RunArrays& out, SimResult& R, int cpu = 0) {
+        out.turnaround[k] = t - ps.arrival[k];
+        out.waiting[k]    = out.turnaround[k] - ps.burst[k];
+        R.acc.add(out.waiting[k], out.turnaround[k], out.response[k]);
+        segment(R, cpu, k, t);
+        if (R.trace) R.trace->result(cpu, k, t, out.response[k]);
+    }
+    // count a decision; the first one for a job fixes its response time
+    static void dispatch(const ProcTable& ps, int idx, int t, RunArrays& out, SimResult& R) {
+        R.decisions++;
+        if (out.response[idx] < 0) out.response[idx] = t - ps.arrival[idx];
+    }
+    // record the end of the previous slice when the CPU moves to another job
+    static void switchTo(const ProcTable& ps, int idx, int& last, int t, RunArrays& out, SimResult& R) {
+        dispatch(ps, idx, t, out, R);
+        if (R.stats && idx!=last) R.stats->switches++;
+        if (idx!=last && last!=-1) segment(R, 0, last, t);
+        last = idx;
+    }
+};
+
+static constexpr size_t kGanttPerJob = 8;
+
+void Scheduler::simulate(const ProcTable& ps, RunArrays& out, SimResult& R) {
+    uint64_t allocs = tAllocs;
+    vector<int>& rem = out.remaining;
+    const int n = ps.size();
+    EventCore core;
+    auto pol = policy(ps, out, core);
+    int t = 0, done = 0, last = -1, cur = -1, since = 0, end = -1;
+
+    // one Gantt entry per completion plus at most one per expiry or preemption;
+    // slice(k) before the first pick is the shortest slice k can get. The bound
+    // follows total burst, which can dwarf the real chart (a lone job runs back to
+    // back), so reserve at most kGanttPerJob entries per job and let the rest grow
+    size_t slices = n;
+    for (int k=0; k<n; k++) slices += rem[k] > 0 ? (rem[k] - 1) / pol->slice(k) : 0;
+    if (pol->preemptOnArrival()) slices += n;
+    if (R.keepGantt) R.gantt.reserve(min(slices, kGanttPerJob * n));
+
+    Checkpointer* ckpt = R.checkpoint;
+    if (R.resume) {
+        LoopState s = resume(ps, out, R, core, *pol);
+        t = s.t; done = s.done; last = s.last; cur = s.cur; since = s.since; end = s.end;
+    } else {
+        core.push(ps.arrival[0], EvArrival, 0);
+    }
+    R.setupAllocs = tAllocs - allocs; allocs = tAllocs;
+
+    // the running slice ends after `ran` ticks, by quantum, completion or preemption
+    auto stop = [&](int ran) {
+        int k = cur; cur = -1;
+        rem[k] -= ran;
+        if (rem[k]==0) { complete(ps, k, t, out, R); last=-1; done++; pol->finish(k, t, ran); }
+        else pol->expire(k, t, ran);
+    };
+
+    while (done<n) {
+        if (ckpt && ckpt->due(core.top().time))
+            checkpoint(ps, out, R, core, *pol, {t, done, last, cur, since, end}, core.top().time);
+        Event e = core.pop();
+        if (cur<0) {
+            R.idle += e.time - t;
+            if (R.stats && e.time > t) R.stats->idleJumps++;
+        }
+        t = e.time;
+        switch (e.type()) {
+        case EvArrival:
+            if (cur>=0 && pol->preemptOnArrival()) { core.cancel(end); stop(t - since); }
+            pol->arrive(e.job, t);
+            if (e.job+1<n) core.push(ps.arrival[e.job+1], EvArrival, e.job+1);
+            break;
+        case EvAging:
+            pol->timer(e.job, t);
+            break;
+        default:
+            stop(t - since);
+        }
+        if (cur>=0 || (!core.empty() && core.top().time==t)) continue;
+
+        if (R.stats) R.stats->readyLen.record(pol->queued());
+        int k = pol->pick(t);
+        if (k<0) continue;
+        switchTo(ps, k, last, t, out, R);
+        cur = k; since = t;
+        pol->start(k, t);
+        int len = min(pol->slice(k), rem[k]);
+        end = core.push(t + len, len==rem[k] ? EvCompletion : EvExpiry, k);
+    }
+    R.total_time = t;
+    R.loopAllocs = tAllocs - allocs;
+    if (R.stats) R.stats->promotions = pol->promotions();
+}
+
+// Snapshot before the first event at time b: the loop's locals, results so far,
+// pending events and the policy. Kept out of line, like resume(), so the loop's
+// locals never have their address taken and stay in registers.
+__attribute__((noinline))
+void Scheduler::checkpoint(const ProcTable& ps, const RunArrays& out, const SimResult& R, const EventCore& core,
+                           const EventPolicy& pol, LoopState s, int b) const {
+    int cut = ps.size();
+    core.each([&](const Event& e){ if (e.type()==EvArrival) cut = e.job; });
+    SnapWriter w;
+    w.val(s);
+    w.val(R.decisions); w.val(R.idle);
+    R.acc.save(w);
+    w.val<uint8_t>(R.keepGantt);
+    if (R.keepGantt) w.items(R.gantt);
+    w.rows(out.waiting, cut); w.rows(out.turnaround, cut); w.rows(out.response, cut); w.rows(out.remaining, cut);
+    core.save(w);
+    pol.save(w, cut);
+    R.checkpoint->write(ps, name(), b, cut, s.done, w.buf);
+}
+
+// Inverse of checkpoint(). The pending arrival is re-read from this table, which
+// may differ from the snapshot's past its first `cut` rows.
+__attribute__((noinline))
+LoopState Scheduler::resume(const ProcTable& ps, RunArrays& out, SimResult& R, EventCore& core, EventPolicy& pol) {
+    const int n = ps.size(), cut = R.resume->cut;
+    SnapReader in(R.resume->payload);
+    LoopState s = in.val<LoopState>();
+    in.val(R.decisions); in.val(R.idle);
+    R.acc.load(in);
+    if (in.val<uint8_t>()) {
+        in.items(R.gantt);
+        if (!R.keepGantt) { R.gantt.clear(); R.gantt.shrink_to_fit(); }
+    } else if (R.keepGantt) throw runtime_error("Snapshot has no Gantt chart; resume with --no-gantt");
+    in.rows(out.waiting); in.rows(out.turnaround); in.rows(out.response); in.rows(out.remaining);
+    core.load(in, [&](const Event& e) {
+        if (e.type()==EvArrival) return;
+        int id = core.restore(e);
+        if (e.type()==EvExpiry || e.type()==EvCompletion) s.end = id;
+    });
+    if (cut < n) core.push(ps.arrival[cut], EvArrival, cut);
+    pol.load(in, cut);
+    if (!in.done()) throw runtime_error("Bad snapshot (trailing data)");
+    return s;
+}
+
+
+/* ---------- FCFS ---------- */
+class FCFSScheduler : public Scheduler {
+    struct Policy : EventPolicy {
+        RingQueue q;
+        explicit Policy(const ProcTable& ps): q(ps.size()) {}
+        void arrive(int k, int) override { q.push(k); }
+        int pick(int) override { if (q.empty()) return -1; int k=q.front(); q.pop(); return k; }
+        size_t queued() const override { return q.size(); }
+        void save(SnapWriter& w, int) const override { q.save(w); }
+        void load(SnapReader& r, int) override { q.load(r); }
+    };
+public:
+    string name() const override { return "FCFS"; }
+    unique_ptr<EventPolicy> policy(const ProcTable& ps, RunArrays&, EventCore&) const override {
+        return make_unique<Policy>(ps);
+    }
+};
+
+/* ---------- SJF (non-preemptive, heap ready set) ---------- */
+class SJFScheduler : public Scheduler {
+    // ready set as a min-heap on (burst, index); ps is sorted by (arrival, id),
+    // so index order is exactly the (arrival, id) tie-break
+    struct Policy : EventPolicy {
+        const ProcTable& ps;
+        MinHeap<pair<int,int>> ready;
+        explicit Policy(const ProcTable& ps): ps(ps), ready(reservedHeap<pair<int,int>>(ps.size())) {}
+        void arrive(int k, int) override { ready.push({ps.burst[k], k}); }
+        int pick(int) override {
+            if (ready.empty()) return -1;
+            int k = ready.top().second; ready.pop(); return k;
+        }
+        size_t queued() const override { return ready.size(); }
+        void save(SnapWriter& w, int) const override { w.items(heapItems(ready)); }
+        void load(SnapReader& r, int) override { r.items(heapItems(ready)); }
+    };
+public:
+    string name() const override { return "SJF"; }
+    unique_ptr<EventPolicy> policy(const ProcTable& ps, RunArrays&, EventCore&) const override {
+        return make_unique<Policy>(ps);
+    }
+};
+
+/* ---------- SRTF (preemptive SJF) ---------- */
+// The picked job stays in the ready set while it runs and is re-keyed when its
+// slice ends. Only an arrival can preempt, so every arrival ends the slice and
+// the next pick decides whether the newcomer wins.
+template <class Ready>
+class SRTFScheduler : public Scheduler {
+    struct Policy : EventPolicy {
+        const vector<int>& rem;
+        Ready ready;            // (remaining, index): index order is the (arrival, id) tie-break
+        explicit Policy(const vector<int>& rem): rem(rem) { ready.reserve(rem.size()); }
+        void arrive(int k, int) override { ready.push(rem[k], k); }
+        int pick(int) override { return ready.empty() ? -1 : ready.top(); }
+        size_t queued() const override { return ready.size(); }
+        bool preemptOnArrival() const override { return true; }
+        void expire(int k, int, int) override { ready.rekeyTop(rem[k]); }
+        void finish(int, int, int) override { ready.pop(); }
+        void save(SnapWriter& w, int) const override { ready.save(w); }
+        void load(SnapReader& r, int) override { ready.load(r); }
+    };
+public:
+    string name() const override { return string("SRTF") + Ready::tag; }
+    unique_ptr<EventPolicy> policy(const ProcTable&, RunArrays& out, EventCore&) const override {
+        return make_unique<Policy>(out.remaining);
+    }
 };
 
-static void printGantt(const vector<pair<string,int>>& gantt) {
-    cout << "Gantt Chart: ";
-    for (auto &e : gantt) cout << e.first << "(" << e.second << ") ";
-    cout << "\n";
-}
+/* ---------- Priority (non-preemptive, aging via buckets) ---------- */
+// Ready jobs bucketed by effective priority (base priority minus one step per
+// AGING_INTERVAL ticks since arrival), each bucket ordered on the ex04 tie-break
+// (base priority, arrival, burst, id); index order is (arrival, id). `where` maps
+// a job to its global bucket slot and is shared by every queue over the same
+// table, so SMP runqueues can tell whether a stale aging entry is still theirs.
+class AgingBuckets {
+public:
+    static constexpr int AGING_INTERVAL = 5; // one priority step per 5 ticks waited
+
+    // bucket nodes come from `arena`, which may be shared by several queues
+    AgingBuckets(const ProcTable& ps, int maxP, vector<int>& where, Arena& arena, int self = 0)
+        : ps(ps), where(where), base(self * (maxP+1)), bucket(maxP+1, ArenaSet<Key>(ArenaAlloc<Key>(arena))),
+          nonempty((maxP+64)/64, 0), aging(reservedHeap<pair<int,int>>(ps.size())) {}
 
-static void calcAndPrintMetrics(vector<Process>& ps, int total_time) {
-    double avg_wait = 0.0, avg_turn = 0.0;
-    int busy = 0;
-    for (auto &p : ps) {
-        avg_wait += p.waiting_time;
-        avg_turn += p.turnaround_time;
-        busy += p.burst_time;
+    // at most kMaxPriority, which the loaders enforce
+    static int maxPriority(const ProcTable& ps) {
+        int maxP = 0;
+        for (size_t k=0; k<ps.size(); k++) maxP = max(maxP, ps.priority[k]);
+        return maxP;
     }
-    avg_wait /= ps.size();
-    avg_turn /= ps.size();
-    double cpu_util = (total_time > 0) ? (100.0 * busy / total_time) : 0.0;
-    double throughput = (total_time > 0) ? (double)ps.size() / total_time : 0.0;
 
-    cout << "Avg Waiting Time: " << avg_wait << "\n";
-    cout << "Avg Turnaround Time: " << avg_turn << "\n";
-    cout << "CPU Utilization: " << cpu_util << "%\n";
-    cout << "Throughput (jobs / time): " << throughput << "\n";
-}
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+    void push(int k, int now) { int e = effAt(k, now); put(k, e); scheduleAging(k, e); }
+    // move every job whose effective priority dropped by `now` to its new bucket
+    void age(int now) {
+        while (!aging.empty() && aging.top().first<=now) {
+            int k = aging.top().second; aging.pop();
+            if (!mine(k)) continue; // already ran or migrated
+            int e = effAt(k, now);
+            take(k); put(k, e); scheduleAging(k, e);
+            promoted++;
+        }
+    }
+    long long promotions() const { return promoted; }
+    // single-queue snapshots: the buckets are rebuilt from each row's slot
+    void save(SnapWriter& w, int cut) const { w.rows(where, cut); w.items(heapItems(aging)); w.val(promoted); }
+    void load(SnapReader& r) {
+        size_t cut = r.rows(where);
+        for (size_t k=0; k<cut; k++)
+            if (where[k] >= 0) put(k, where[k] - base);
+        r.items(heapItems(aging)); r.val(promoted);
+    }
+    int popBest() {
+        int w = 0;
+        while (!nonempty[w]) w++;
+        int k = get<3>(*bucket[w*64 + __builtin_ctzll(nonempty[w])].begin());
+        take(k); return k;
+    }
+    int popWorst() {
+        int w = nonempty.size() - 1;
+        while (!nonempty[w]) w--;
+        int k = get<3>(*bucket[w*64 + 63 - __builtin_clzll(nonempty[w])].rbegin());
+        take(k); return k;
+    }
 
-/* Default table (matches your doc) */
-static vector<Process> defaultTable() {
-    return {
-        {"P1", 0, 8, 2, 8},
-        {"P2", 1, 4, 1, 4},
-        {"P3", 2, 9, 3, 9},
-        {"P4", 3, 5, 4, 5},
+private:
+    using Key = tuple<int,int,int,int>;
+    const ProcTable& ps;
+    vector<int>& where;
+    int base;
+    size_t count = 0;
+    long long promoted = 0;
+    vector<ArenaSet<Key>> bucket;
+    vector<uint64_t> nonempty;
+    // (time the job next drops a bucket, index)
+    MinHeap<pair<int,int>> aging;
+
+    Key key(int k) const { return Key{ps.priority[k], ps.arrival[k], ps.burst[k], k}; }
+    int effAt(int k, int now) const { return max(0, ps.priority[k] - (now - ps.arrival[k]) / AGING_INTERVAL); }
+    bool mine(int k) const { return where[k] >= base && where[k] < base + (int)bucket.size(); }
+    void put(int k, int e) {
+        where[k] = base + e; bucket[e].insert(key(k)); count++;
+        nonempty[e>>6] |= 1ULL<<(e&63);
+    }
+    void take(int k) {
+        int e = where[k] - base; where[k] = -1; bucket[e].erase(key(k)); count--;
+        if (bucket[e].empty()) nonempty[e>>6] &= ~(1ULL<<(e&63));
+    }
+    void scheduleAging(int k, int e) {
+        if (e>0) aging.push({ps.arrival[k] + AGING_INTERVAL*(ps.priority[k] - e + 1), k});
+    }
+};
+
+// Buckets are ordered on a static key, so aging can be applied lazily at each
+// pick; the buckets keep their own timer heap instead of the core's.
+class PriorityScheduler : public Scheduler {
+    struct Policy : EventPolicy {
+        vector<int> where;
+        Arena arena;
+        AgingBuckets ready;
+        explicit Policy(const ProcTable& ps)
+            : where(ps.size(), -1), arena(ps.size() * kSetNodeBytes),
+              ready(ps, AgingBuckets::maxPriority(ps), where, arena) {}
+        void arrive(int k, int now) override { ready.push(k, now); }
+        int pick(int now) override { ready.age(now); return ready.empty() ? -1 : ready.popBest(); }
+        size_t queued() const override { return ready.size(); }
+        long long promotions() const override { return ready.promotions(); }
+        void save(SnapWriter& w, int cut) const override { ready.save(w, cut); }
+        void load(SnapReader& r, int) override { ready.load(r); }
     };
-}
+public:
+    string name() const override { return "Priority"; }
+    unique_ptr<EventPolicy> policy(const ProcTable& ps, RunArrays&, EventCore&) const override {
+        return make_unique<Policy>(ps);
+    }
+};
 
-/* Optional CSV loader: id,arrival,burst,priority  (header optional) */
-static vector<Process> loadCSV(const string& filename) {
-    ifstream f(filename);
-    if (!f) throw runtime_error("Failed to open input file: " + filename);
-    vector<Process> ps;
-    string line;
-    bool first = true;
-    while (getline(f, line)) {
-        if (line.empty()) continue;
-        // skip header rows containing non-digits in second column
-        if (first) {
-            first = false;
-            // peek: if not a data row, continue (e.g., header)
-            string tmp = line;
-            replace(tmp.begin(), tmp.end(), ',', ' ');
-            string id; string a,b,p;
-            stringstream ss(tmp);
-            if (!(ss >> id >> a >> b >> p)) continue;
-            bool ad = all_of(a.begin(), a.end(), [](char c){ return c=='-' || isdigit((unsigned char)c); });
-            if (!ad) continue; // header
-        }
-        string id; int a,b,p;
-        char comma;
-        stringstream ss(line);
-        if (!(ss >> id)) continue;
-        if (ss.peek()==',') ss >> comma;
-        ss >> a;
-        if (ss.peek()==',') ss >> comma;
-        ss >> b;
-        if (ss.peek()==',') ss >> comma;
-        if (!(ss >> p)) p = 3; // default priority if missing
-        ps.push_back({id, a, b, p, b});
+/* ---------- Round Robin (preemptive, quantum) ---------- */
+// Arrivals up to the end of a slice queue ahead of the preempted job, exactly as
+// a per-tick loop would order them.
+class RRScheduler : public Scheduler {
+    int quantum;
+    struct Policy : EventPolicy {
+        RingQueue q;
+        int quantum;
+        Policy(const ProcTable& ps, int quantum): q(ps.size()), quantum(quantum) {}
+        void arrive(int k, int) override { q.push(k); }
+        int pick(int) override { if (q.empty()) return -1; int k=q.front(); q.pop(); return k; }
+        size_t queued() const override { return q.size(); }
+        int slice(int) const override { return quantum; }
+        void expire(int k, int, int) override { q.push(k); }
+        void save(SnapWriter& w, int) const override { q.save(w); }
+        void load(SnapReader& r, int) override { q.load(r); }
+    };
+public:
+    explicit RRScheduler(int q): quantum(q>0?q:4) {}
+    string name() const override { return "RR(q="+to_string(quantum)+")"; }
+    unique_ptr<EventPolicy> policy(const ProcTable& ps, RunArrays&, EventCore&) const override {
+        return make_unique<Policy>(ps, quantum);
     }
-    if (ps.empty()) throw runtime_error("No processes parsed from " + filename);
-    return ps;
-}
+};
 
-/* Random generator  */
-static vector<Process> generateRandom(int n, unsigned seed=42) {
-    mt19937 rng(seed);
-    uniform_int_distribution<int> A(0, 20), B(1, 12), P(1, 4);
-    vector<Process> ps;
-    for (int i=1;i<=n;i++) {
-        int a=A(rng), b=B(rng), p=P(rng);
-        ps.push_back({"P"+to_string(i), a, b, p, b});
+/* ---------- MLQ (high queue RR, low queue FCFS) ---------- */
+class MLQScheduler : public Scheduler {
+    int quantum;
+    struct Policy : EventPolicy {
+        const ProcTable& ps;
+        RingQueue highQ, lowQ;      // priority < 3 goes to the high queue
+        int quantum;
+        Policy(const ProcTable& ps, int quantum): ps(ps), highQ(ps.size()), lowQ(ps.size()), quantum(quantum) {}
+        void arrive(int k, int) override { (ps.priority[k]<3 ? highQ : lowQ).push(k); }
+        int pick(int) override {
+            if (highQ.empty() && lowQ.empty()) return -1;
+            RingQueue& q = !highQ.empty() ? highQ : lowQ;
+            int k=q.front(); q.pop(); return k;
+        }
+        // high queue runs one quantum, low queue runs to completion
+        int slice(int k) const override { return ps.priority[k]<3 ? quantum : INT_MAX; }
+        size_t queued() const override { return highQ.size() + lowQ.size(); }
+        void expire(int k, int, int) override { highQ.push(k); }
+        void save(SnapWriter& w, int) const override { highQ.save(w); lowQ.save(w); }
+        void load(SnapReader& r, int) override { highQ.load(r); lowQ.load(r); }
+    };
+public:
+    explicit MLQScheduler(int q): quantum(q>0?q:4) {}
+    string name() const override { return "MLQ(q="+to_string(quantum)+")"; }
+    unique_ptr<EventPolicy> policy(const ProcTable& ps, RunArrays&, EventCore&) const override {
+        return make_unique<Policy>(ps, quantum);
     }
-    sort(ps.begin(), ps.end(), [](auto&a, auto&b){
-        if (a.arrival_time!=b.arrival_time) return a.arrival_time<b.arrival_time;
-        return a.id<b.id;
-    });
-    return ps;
-}
+};
 
+/* ---------- MLFQ (3 levels, aging timers) ---------- */
+class MLFQScheduler : public Scheduler {
+    static constexpr int Q0_Q = 3, Q1_Q = 6;      // RR quanta; Q2 is FCFS
+    static constexpr int AGE_THRESHOLD = 12;      // promote if waited this long
+    struct Policy : EventPolicy {
+        EventCore& core;
+        vector<int> enq_time;
+        // every push stamps the current time, so each level is ordered by enqueue
+        // time and only its front can be the next to age
+        RingQueue Q[3];
+        int level = 0;              // level the running job was taken from
+        long long promoted = 0;
+        Policy(const ProcTable& ps, EventCore& core): core(core), enq_time(ps.size(), 0) {
+            for (auto &q : Q) q = RingQueue(ps.size());
+        }
 
-class Scheduler {
+        void push(int lvl, int k, int now) {
+            enq_time[k]=now; Q[lvl].push(k);
+            if (lvl>0) core.timer(now + AGE_THRESHOLD, k);
+        }
+        void arrive(int k, int now) override { push(0, k, now); }
+        // Q2->Q1 first, then Q1->Q0, same order as ex07's full-queue rotation;
+        // one timer per push, so stale ones find nothing due
+        void timer(int, int now) override {
+            for (int lvl=2; lvl>=1; lvl--)
+                while (!Q[lvl].empty() && now - enq_time[Q[lvl].front()] >= AGE_THRESHOLD) {
+                    int k=Q[lvl].front(); Q[lvl].pop();
+                    push(lvl-1, k, now); promoted++;
+                }
+        }
+        int pick(int) override {
+            level = 0;
+            while (level<3 && Q[level].empty()) level++;
+            if (level==3) return -1;
+            int k=Q[level].front(); Q[level].pop(); return k;
+        }
+        int slice(int) const override { return level==0 ? Q0_Q : level==1 ? Q1_Q : INT_MAX; }
+        void expire(int k, int now, int) override { push(min(2, level+1), k, now); } // demote
+        size_t queued() const override { return Q[0].size() + Q[1].size() + Q[2].size(); }
+        long long promotions() const override { return promoted; }
+        // aging timers are events, saved by the engine
+        void save(SnapWriter& w, int cut) const override {
+            w.rows(enq_time, cut);
+            for (auto &q : Q) q.save(w);
+            w.val(level); w.val(promoted);
+        }
+        void load(SnapReader& r, int) override {
+            r.rows(enq_time);
+            for (auto &q : Q) q.load(r);
+            r.val(level); r.val(promoted);
+        }
+    };
 public:
-    virtual ~Scheduler() = default;
-    // Implementations must fill ps[*].waiting_time & turnaround_time
-    virtual SimResult run(vector<Process> ps) = 0;
-    virtual string name() const = 0;
+    string name() const override { return "MLFQ"; }
+    unique_ptr<EventPolicy> policy(const ProcTable& ps, RunArrays&, EventCore& core) const override {
+        return make_unique<Policy>(ps, core);
+    }
 };
 
+/* ---------- Lottery (Fenwick tree over ticket counts) ---------- */
+class LotteryScheduler : public Scheduler {
+    int quantum;
+    unsigned seed;
 
-class FCFSScheduler : public Scheduler {
+    // ex08's rule when the CSV gives no tickets: 10 per priority step above 5
+    static long long ticketsOf(const ProcTable& ps, int k) {
+        if (ps.tickets[k] > 0) return ps.tickets[k];
+        return max(1, 5 - ps.priority[k]) * 10;
+    }
+    // Fenwick tree of ready tickets by index; a draw of r picks the job whose
+    // prefix range covers r, i.e. the same job as ex08's materialised pool
+    struct Policy : EventPolicy {
+        const ProcTable& ps;
+        const vector<int>& rem;
+        int n, top = 1, quantum;
+        vector<long long> fen;
+        long long total = 0;
+        mt19937 rng;
+        Policy(const ProcTable& ps, const vector<int>& rem, int quantum, unsigned seed)
+            : ps(ps), rem(rem), n(ps.size()), quantum(quantum), fen(n+1, 0), rng(seed) {
+            while (top*2<=n) top*=2;
+        }
+        void add(int k, long long v) {
+            total += v;
+            for (k++; k<=n; k+=k&-k) fen[k]+=v;
+        }
+        int find(long long r) const {   // smallest k with prefix(k) > r
+            int pos = 0;
+            for (int step=top; step; step>>=1)
+                if (pos+step<=n && fen[pos+step]<=r) { pos+=step; r-=fen[pos]; }
+            return pos;
+        }
+        size_t ready = 0;
+        void arrive(int k, int) override { add(k, ticketsOf(ps, k)); ready++; }
+        int pick(int) override {
+            if (total==0) return -1;
+            uniform_int_distribution<long long> dist(0, total-1);
+            return find(dist(rng));
+        }
+        int slice(int) const override { return quantum; }
+        void finish(int k, int, int) override { add(k, -ticketsOf(ps, k)); ready--; }
+        size_t queued() const override { return ready; }
+        // the tree is rebuilt from the unfinished rows; the generator is saved whole
+        void save(SnapWriter& w, int) const override { ostringstream os; os << rng; w.str(os.str()); }
+        void load(SnapReader& r, int cut) override {
+            istringstream is(r.str());
+            if (!(is >> rng)) throw runtime_error("Bad snapshot (lottery generator)");
+            for (int k=0; k<cut; k++) if (rem[k] > 0) { add(k, ticketsOf(ps, k)); ready++; }
+        }
+    };
 public:
-    string name() const override { return "FCFS"; }
-    SimResult run(vector<Process> ps) override {
-        sort(ps.begin(), ps.end(), [](auto&a, auto&b){
-            if (a.arrival_time!=b.arrival_time) return a.arrival_time<b.arrival_time;
-            return a.id<b.id;
-        });
-        SimResult R;
-        int t=0;
-        for (auto &p : ps) {
-            if (t < p.arrival_time) t = p.arrival_time;
-            p.waiting_time = t - p.arrival_time;
-            t += p.burst_time;
-            p.turnaround_time = t - p.arrival_time;
-            R.gantt.push_back({p.id, t});
+    LotteryScheduler(int q, unsigned s): quantum(q>0?q:4), seed(s) {}
+    string name() const override { return "Lottery(q="+to_string(quantum)+")"; }
+    unique_ptr<EventPolicy> policy(const ProcTable& ps, RunArrays& out, EventCore&) const override {
+        return make_unique<Policy>(ps, out.remaining, quantum, seed);
+    }
+};
+
+/* ---------- CFS (vruntime-ordered runqueue) ---------- */
+// sched_prio_to_weight[] from the Linux kernel, indexed by nice+20
+static const int kNiceToWeight[40] = {
+    88761, 71755, 56483, 46273, 36291,
+    29154, 23254, 18705, 14949, 11916,
+     9548,  7620,  6100,  4904,  3906,
+     3121,  2501,  1991,  1586,  1277,
+     1024,   820,   655,   526,   423,
+      335,   272,   215,   172,   137,
+      110,    87,    70,    56,    45,
+       36,    29,    23,    18,    15,
+};
+
+// vruntime is kept in fixed point: one tick at nice 0 advances it by 1024<<10
+static constexpr long long kCFSVScale = 1024LL << 10;
+
+// The CSV priority maps to nice = priority-3, so the default priority 3 runs at nice 0.
+static int cfsWeight(int priority) {
+    int nice = min(19, max(-20, priority - 3));
+    return kNiceToWeight[nice + 20];
+}
+
+class CFSScheduler : public Scheduler {
+    int slice;
+    static constexpr long long VSCALE = kCFSVScale;
+    struct Policy : EventPolicy {
+        vector<long long> vr;
+        vector<int> w;
+        // runqueue ordered on (vruntime, index); index order is the (arrival, id) tie-break
+        MinHeap<pair<long long,int>> rq;
+        long long min_vr = 0;
+        int sliceLen, curr = -1, since = 0;
+        Policy(const ProcTable& ps, int slice)
+            : vr(ps.size(), 0), w(ps.size()), rq(reservedHeap<pair<long long,int>>(ps.size())), sliceLen(slice) {
+            for (size_t k=0; k<ps.size(); k++) w[k] = cfsWeight(ps.priority[k]);
         }
-        R.total_time = t;
-        calcAndPrintMetrics(ps, R.total_time);
-        printGantt(R.gantt);
-        return R;
+        void arrive(int k, int now) override {
+            if (curr>=0) {  // arrivals during a slice see min_vruntime as of their arrival tick
+                long long cur = vr[curr] + (now - since) * VSCALE / w[curr];
+                if (!rq.empty()) cur = min(cur, rq.top().first);
+                min_vr = max(min_vr, cur);
+            }
+            vr[k]=min_vr; rq.push({vr[k], k});
+        }
+        int pick(int) override {
+            if (rq.empty()) return -1;
+            int k = rq.top().second; rq.pop(); return k;
+        }
+        int slice(int) const override { return sliceLen; }
+        size_t queued() const override { return rq.size(); }
+        void start(int k, int now) override { curr = k; since = now; }
+        void finish(int k, int, int ran) override {
+            vr[k] += ran * VSCALE / w[k]; curr = -1;
+            if (!rq.empty()) min_vr = max(min_vr, rq.top().first);
+        }
+        void expire(int k, int, int ran) override {
+            vr[k] += ran * VSCALE / w[k]; curr = -1;
+            rq.push({vr[k], k});
+            min_vr = max(min_vr, rq.top().first);
+        }
+        void save(SnapWriter& w, int cut) const override {
+            w.rows(vr, cut); w.items(heapItems(rq)); w.val(min_vr); w.val(curr); w.val(since);
+        }
+        void load(SnapReader& r, int) override {
+            r.rows(vr); r.items(heapItems(rq)); r.val(min_vr); r.val(curr); r.val(since);
+        }
+    };
+public:
+    explicit CFSScheduler(int s): slice(s>0?s:4) {}
+    string name() const override { return "CFS(slice="+to_string(slice)+")"; }
+    unique_ptr<EventPolicy> policy(const ProcTable& ps, RunArrays&, EventCore&) const override {
+        return make_unique<Policy>(ps, slice);
+    }
+};
+
+/* ---------- EDF (preemptive) ---------- */
+// Deadlines are fixed, so only an arrival can preempt and the running job keeps its key.
+template <class Ready>
+class EDFScheduler : public Scheduler {
+    struct Policy : EventPolicy {
+        const ProcTable& ps;
+        Ready ready;            // (deadline, index): index order is the (arrival, id) tie-break
+        explicit Policy(const ProcTable& ps): ps(ps) { ready.reserve(ps.size()); }
+        void arrive(int k, int) override { ready.push(deadlineOf(ps, k), k); }
+        int pick(int) override { return ready.empty() ? -1 : ready.top(); }
+        size_t queued() const override { return ready.size(); }
+        bool preemptOnArrival() const override { return true; }
+        void finish(int, int, int) override { ready.pop(); }
+        void save(SnapWriter& w, int) const override { ready.save(w); }
+        void load(SnapReader& r, int) override { ready.load(r); }
+    };
+public:
+    string name() const override { return string("EDF") + Ready::tag; }
+    unique_ptr<EventPolicy> policy(const ProcTable& ps, RunArrays&, EventCore&) const override {
+        return make_unique<Policy>(ps);
     }
+    void report(const ProcTable& ps, const RunArrays& out) override { printDeadlineMetrics(ps, out); }
 };
 
+/* ---------- SMP mode (per-CPU runqueues) ----------
+   N CPUs, each with its own runqueue. New arrivals go to the CPU chosen by the
+   placement policy; after that a job only moves when it migrates, either pulled
+   by an idle CPU with an empty queue (work stealing) or pushed by a periodic
+   balancer that evens queue lengths out. Events are handled in a fixed order at
+   each instant: arrivals, slice ends (in CPU order), balancing, dispatch from
+   own queues, then steals, each in CPU order. Runs are deterministic and
+   --cpus 1 reproduces the single-CPU engines. */
+struct SMPOptions {
+    int cpus = 0;                     // 0: classic single-CPU engines
+    string placement = "least";       // least | rr | random
+    int balance = 0;                  // 0: idle CPUs steal; N: rebalance every N ticks
+};
 
-class SJFScheduler : public Scheduler {
+// One CPU's ready set. Jobs are table rows; the running job is not in the queue.
+class CPURunQueue {
 public:
-    string name() const override { return "SJF"; }
-    SimResult run(vector<Process> ps) override {
-        sort(ps.begin(), ps.end(), [](auto&a, auto&b){
-            if (a.arrival_time!=b.arrival_time) return a.arrival_time<b.arrival_time;
-            return a.id<b.id;
-        });
-        const int n=ps.size();
-        vector<bool> done(n,false);
-        SimResult R;
-        int fin=0, t=0;
-        while (fin<n) {
-            // find ready
-            vector<int> ready;
-            for (int i=0;i<n;i++) if (!done[i] && ps[i].arrival_time<=t) ready.push_back(i);
-            if (ready.empty()) {
-                int nxt=INT_MAX; for (int i=0;i<n;i++) if(!done[i]) nxt=min(nxt, ps[i].arrival_time);
-                t=nxt; continue;
-            }
-            // pick shortest burst
-            int pick = *min_element(ready.begin(), ready.end(), [&](int i,int j){
-                if (ps[i].burst_time!=ps[j].burst_time) return ps[i].burst_time<ps[j].burst_time;
-                if (ps[i].arrival_time!=ps[j].arrival_time) return ps[i].arrival_time<ps[j].arrival_time;
-                return ps[i].id<ps[j].id;
-            });
-            auto &p = ps[pick];
-            p.waiting_time = t - p.arrival_time;
-            t += p.burst_time;
-            p.turnaround_time = t - p.arrival_time;
-            R.gantt.push_back({p.id, t});
-            done[pick]=true; fin++;
-        }
-        R.total_time=t;
-        calcAndPrintMetrics(ps, R.total_time);
-        printGantt(R.gantt);
-        return R;
+    virtual ~CPURunQueue() = default;
+    virtual size_t size() const = 0;
+    virtual void add(int k, int now) = 0;           // new arrival placed here
+    virtual int next(int now) = 0;                  // remove the job to run, -1 if empty
+    virtual int slice(int k, int rem) const = 0;    // run length before the next decision
+    virtual void start(int, int) {}                 // job k starts running at now
+    virtual void stop(int k, int now, int ran, bool finished) = 0; // slice ended; requeue unless finished
+    virtual int steal(int now) = 0;                 // remove a job for another CPU, -1 if empty
+    virtual void adopt(int k, int now) = 0;         // job stolen from another CPU
+    virtual long long promotions() const { return 0; }
+};
+
+class RRRunQueue : public CPURunQueue {             // FIFO, preempted jobs to the tail
+    RingQueue q;
+    int quantum;
+public:
+    RRRunQueue(size_t n, int quantum): q(n), quantum(quantum) {}
+    size_t size() const override { return q.size(); }
+    void add(int k, int) override { q.push(k); }
+    int next(int) override { if (q.empty()) return -1; int k=q.front(); q.pop(); return k; }
+    int slice(int, int rem) const override { return min(quantum, rem); }
+    void stop(int k, int, int, bool finished) override { if (!finished) q.push(k); }
+    int steal(int) override { if (q.empty()) return -1; int k=q.back(); q.pop_back(); return k; }
+    void adopt(int k, int) override { q.push(k); }
+};
+
+// Same placement rule as CFSScheduler. A migrating job keeps its vruntime relative
+// to the queue's min_vruntime, as Linux does.
+class CFSRunQueue : public CPURunQueue {
+    const ProcTable& ps;
+    vector<long long>& vr;            // shared across queues, indexed by row
+    const vector<int>& w;
+    int sliceLen;
+    ArenaSet<pair<long long,int>> rq;
+    long long min_vr = 0;
+    int curr = -1, currStart = 0;
+public:
+    CFSRunQueue(const ProcTable& ps, vector<long long>& vr, const vector<int>& w, int slice, Arena& arena)
+        : ps(ps), vr(vr), w(w), sliceLen(slice), rq(ArenaAlloc<pair<long long,int>>(arena)) {}
+    size_t size() const override { return rq.size(); }
+    void add(int k, int now) override {
+        if (curr >= 0) {    // arrivals during a slice see min_vruntime as of their arrival tick
+            long long cur = vr[curr] + (long long)(now - currStart) * kCFSVScale / w[curr];
+            if (!rq.empty()) cur = min(cur, rq.begin()->first);
+            min_vr = max(min_vr, cur);
+        }
+        vr[k] = min_vr; rq.insert({vr[k], k});
+    }
+    int next(int) override {
+        if (rq.empty()) return -1;
+        int k = rq.begin()->second; rq.erase(rq.begin()); return k;
+    }
+    int slice(int, int rem) const override { return min(sliceLen, rem); }
+    void start(int k, int now) override { curr = k; currStart = now; }
+    void stop(int k, int, int ran, bool finished) override {
+        vr[k] += ran * kCFSVScale / w[k];
+        curr = -1;
+        if (!finished) rq.insert({vr[k], k});
+        if (!rq.empty()) min_vr = max(min_vr, rq.begin()->first);
+    }
+    int steal(int) override {
+        if (rq.empty()) return -1;
+        auto it = prev(rq.end());     // the job furthest from running here
+        int k = it->second; rq.erase(it);
+        vr[k] -= min_vr;
+        return k;
     }
+    void adopt(int k, int) override { vr[k] += min_vr; rq.insert({vr[k], k}); }
 };
 
-/* ---------- Round Robin (preemptive, quantum) ---------- */
-class RRScheduler : public Scheduler {
+class PriorityRunQueue : public CPURunQueue {       // non-preemptive, aging buckets
+    AgingBuckets ready;
+public:
+    PriorityRunQueue(const ProcTable& ps, int maxP, vector<int>& where, Arena& arena, int self)
+        : ready(ps, maxP, where, arena, self) {}
+    size_t size() const override { return ready.size(); }
+    void add(int k, int now) override { ready.push(k, now); }
+    int next(int now) override { ready.age(now); return ready.empty() ? -1 : ready.popBest(); }
+    int slice(int, int rem) const override { return rem; }
+    void stop(int, int, int, bool) override {}
+    int steal(int now) override { ready.age(now); return ready.empty() ? -1 : ready.popWorst(); }
+    void adopt(int k, int now) override { ready.push(k, now); }
+    long long promotions() const override { return ready.promotions(); }
+};
+
+class SMPScheduler : public Scheduler {
+    string kind;
     int quantum;
+    unsigned seed;
+    SMPOptions opt;
 public:
-    explicit RRScheduler(int q): quantum(q>0?q:4) {}
-    string name() const override { return "RR(q="+to_string(quantum)+")"; }
+    SMPScheduler(string kind, int quantum, unsigned seed, SMPOptions opt)
+        : kind(move(kind)), quantum(quantum>0 ? quantum : 4), seed(seed), opt(move(opt)) {}
+    string name() const override {
+        string base = kind=="rr" ? "RR(q="+to_string(quantum)+")"
+                    : kind=="cfs" ? "CFS(slice="+to_string(quantum)+")" : "Priority";
+        return base + " x" + to_string(opt.cpus);
+    }
+    void report(const ProcTable&, const RunArrays&) override {
+        cout << "Placement: " << opt.placement << ", balancing: "
+             << (opt.balance ? "every " + to_string(opt.balance) + " ticks" : string("work stealing")) << "\n";
+    }
 
-    SimResult run(vector<Process> ps) override {
-        // init remaining
-        for (auto &p: ps) p.remaining_time = p.burst_time;
-        sort(ps.begin(), ps.end(), [](auto&a, auto&b){
-            if (a.arrival_time!=b.arrival_time) return a.arrival_time<b.arrival_time;
-            return a.id<b.id;
-        });
+    void simulate(const ProcTable& ps, RunArrays& out, SimResult& R) override {
+        uint64_t allocs = tAllocs;
+        vector<int>& rem = out.remaining;
+        const int n = ps.size(), N = opt.cpus;
 
-        SimResult R;
-        queue<int> q; int n=ps.size(), i=0, t=0, done=0; int last=-1;
+        // per-policy shared state, then one runqueue per CPU
+        vector<long long> vr;
+        vector<int> w, where;
+        int maxP = 0;
+        if (kind=="cfs") {
+            vr.assign(n, 0); w.resize(n);
+            for (int k=0; k<n; k++) w[k] = cfsWeight(ps.priority[k]);
+        } else if (kind=="priority") {
+            where.assign(n, -1); maxP = AgingBuckets::maxPriority(ps);
+        }
+        Arena arena(kind=="rr" ? 0 : n * kSetNodeBytes);   // a job is queued on one CPU at a time
+        vector<unique_ptr<CPURunQueue>> rq;
+        for (int c=0; c<N; c++) {
+            if (kind=="rr")       rq.push_back(make_unique<RRRunQueue>(n, quantum));
+            else if (kind=="cfs") rq.push_back(make_unique<CFSRunQueue>(ps, vr, w, quantum, arena));
+            else                  rq.push_back(make_unique<PriorityRunQueue>(ps, maxP, where, arena, c));
+        }
 
-        auto enq_up_to = [&](int upto){
-            while (i<n && ps[i].arrival_time<=upto) { q.push(i); i++; }
-        };
+        R.cpus = N;
+        R.cpu.assign(N, {});
+        vector<int> cur(N, -1), startAt(N, 0), last(N, -1);
+        auto load = [&](int c){ return (long long)rq[c]->size() + (cur[c] >= 0); };
 
-        if (ps[0].arrival_time>0) t = ps[0].arrival_time;
-        enq_up_to(t);
+        mt19937 rng(seed);
+        int rrNext = 0;
+        auto place = [&]() {
+            if (opt.placement=="rr") { int c = rrNext; rrNext = (rrNext+1) % N; return c; }
+            if (opt.placement=="random") return (int)(rng() % N);
+            int best = 0;                                   // least loaded, lowest index
+            for (int c=1; c<N; c++) if (load(c) < load(best)) best = c;
+            return best;
+        };
+        auto migrate = [&](int from, int to, int now) {
+            int k = rq[from]->steal(now);
+            if (k < 0) return false;
+            rq[to]->adopt(k, now);
+            R.cpu[to].migrations++;
+            return true;
+        };
+        auto balance = [&](int now) {
+            while (true) {
+                int hi = 0, lo = 0;
+                for (int c=1; c<N; c++) {
+                    if (load(c) > load(hi)) hi = c;
+                    if (load(c) < load(lo)) lo = c;
+                }
+                if (load(hi) - load(lo) <= 1 || !migrate(hi, lo, now)) return;
+            }
+        };
+        auto queued = [&]() { for (auto &q : rq) if (q->size()) return true; return false; };
 
+        // (slice end, cpu): equal times pop in CPU order
+        MinHeap<pair<int,int>> ends = reservedHeap<pair<int,int>>(N);
+        int i=0, t=0, done=0;
+        R.setupAllocs = tAllocs - allocs; allocs = tAllocs;
+        long long nextBalance = opt.balance;
         while (done<n) {
-            if (q.empty()) {
-                if (i<n) { t=max(t, ps[i].arrival_time); enq_up_to(t); }
-                continue;
+            while (i<n && ps.arrival[i]<=t) { rq[place()]->add(i, t); i++; }
+
+            while (!ends.empty() && ends.top().first==t) {
+                int c = ends.top().second; ends.pop();
+                int k = cur[c], ran = t - startAt[c];
+                rem[k] -= ran; R.cpu[c].busy += ran;
+                bool finished = rem[k]==0;
+                rq[c]->stop(k, t, ran, finished);
+                cur[c] = -1;
+                if (finished) { complete(ps, k, t, out, R, c); last[c] = -1; done++; }
             }
-            int idx=q.front(); q.pop();
-            if (idx!=last && last!=-1) R.gantt.push_back({ps[last].id, t});
-            last=idx;
-
-            int ran=0;
-            while (ran<quantum && ps[idx].remaining_time>0) {
-                ps[idx].remaining_time--; ran++; t++;
-                enq_up_to(t);
+
+            if (opt.balance && t >= nextBalance) {
+                balance(t);
+                nextBalance = t + opt.balance;
             }
-            if (ps[idx].remaining_time==0) {
-                ps[idx].turnaround_time = t - ps[idx].arrival_time;
-                ps[idx].waiting_time    = ps[idx].turnaround_time - ps[idx].burst_time;
-                R.gantt.push_back({ps[idx].id, t}); last=-1; done++;
-            } else {
-                q.push(idx);
+
+            // idle CPUs take from their own queue first, so a job that was just
+            // preempted stays put; only CPUs left with nothing then steal
+            auto run = [&](int c, int k) {
+                dispatch(ps, k, t, out, R);
+                R.cpu[c].dispatches++;
+                if (R.stats) {
+                    R.stats->readyLen.record(rq[c]->size() + 1);
+                    if (k!=last[c]) R.stats->switches++;
+                }
+                if (k!=last[c] && last[c]!=-1) segment(R, c, last[c], t);
+                last[c] = k;
+                cur[c] = k; startAt[c] = t;
+                rq[c]->start(k, t);
+                ends.push({t + rq[c]->slice(k, rem[k]), c});
+            };
+            for (int c=0; c<N; c++)
+                if (cur[c] < 0) { int k = rq[c]->next(t); if (k >= 0) run(c, k); }
+            for (int c=0; c<N; c++) {
+                if (cur[c] >= 0) continue;
+                int k = -1;
+                if (!opt.balance) {                         // steal from the longest queue
+                    int victim = -1;
+                    for (int v=0; v<N; v++)
+                        if (rq[v]->size() && (victim<0 || rq[v]->size() > rq[victim]->size())) victim = v;
+                    if (victim >= 0 && migrate(victim, c, t)) k = rq[c]->next(t);
+                }
+                if (k >= 0) run(c, k);
+                else if (last[c] != -1) { segment(R, c, last[c], t); last[c] = -1; }
             }
+
+            // next instant: a slice end, an arrival, or a due rebalance with work queued
+            long long nt = LLONG_MAX;
+            if (!ends.empty()) nt = ends.top().first;
+            if (i<n) nt = min<long long>(nt, ps.arrival[i]);
+            if (opt.balance && queued()) nt = min(nt, max<long long>(nextBalance, t+1));
+            if (nt == LLONG_MAX) break;
+            if (R.stats && ends.empty() && nt > t) R.stats->idleJumps++;
+            t = nt;
         }
         R.total_time = t;
-        calcAndPrintMetrics(ps, R.total_time);
-        printGantt(R.gantt);
-        return R;
+        R.loopAllocs = tAllocs - allocs;
+        if (R.stats) for (auto &q : rq) R.stats->promotions += q->promotions();
+        long long busy = 0;
+        for (auto &cs : R.cpu) busy += cs.busy;
+        R.idle = (long long)N * t - busy;
     }
 };
 
-
-static unique_ptr<Scheduler> makeScheduler(const string& kind, int quantum) {
+static unique_ptr<Scheduler> makeScheduler(const string& kind, int quantum, unsigned seed,
+                                           const SMPOptions& smp = {}) {
     string k = kind;
     // normalize
     for (auto &c : k) c = tolower((unsigned char)c);
 
-    if (k=="rr" || k=="roundrobin")   return make_unique<RRScheduler>(quantum);
+    if (smp.cpus > 0) {
+        if (k=="roundrobin") k = "rr";
+        if (k=="prio") k = "priority";
+        if (k!="rr" && k!="cfs" && k!="priority")
+            throw runtime_error("Scheduler " + kind + " has no SMP engine (SMP: rr, cfs, priority)");
+        if (smp.placement!="least" && smp.placement!="rr" && smp.placement!="random")
+            throw runtime_error("Unknown placement: " + smp.placement + " (supported: least, rr, random)");
+        // CPU c's aging buckets occupy global slots [c*(kMaxPriority+1), (c+1)*(kMaxPriority+1))
+        if (k=="priority" && smp.cpus > INT_MAX / (kMaxPriority+1))
+            throw runtime_error("Too many CPUs for the priority engine: " + to_string(smp.cpus));
+        return make_unique<SMPScheduler>(k, quantum, seed, smp);
+    }
+
     if (k=="fcfs")                    return make_unique<FCFSScheduler>();
     if (k=="sjf")                     return make_unique<SJFScheduler>();
+    if (k=="srtf")                    return make_unique<SRTFScheduler<HeapReadySet>>();
+    if (k=="srtf-scan")               return make_unique<SRTFScheduler<ScanReadySet>>();
+    if (k=="priority" || k=="prio")   return make_unique<PriorityScheduler>();
+    if (k=="rr" || k=="roundrobin")   return make_unique<RRScheduler>(quantum);
+    if (k=="mlq")                     return make_unique<MLQScheduler>(quantum);
+    if (k=="mlfq")                    return make_unique<MLFQScheduler>();
+    if (k=="lottery")                 return make_unique<LotteryScheduler>(quantum, seed);
+    if (k=="cfs")                     return make_unique<CFSScheduler>(quantum);
+    if (k=="edf")                     return make_unique<EDFScheduler<HeapReadySet>>();
+    if (k=="edf-scan")                return make_unique<EDFScheduler<ScanReadySet>>();
 
     throw runtime_error("Unknown scheduler: " + kind +
-        " (supported: fcfs, sjf, rr)");
+        " (supported: fcfs, sjf, srtf, srtf-scan, priority, rr, mlq, mlfq, lottery, cfs, edf, edf-scan)");
+}
+
+
+/* ---------- Benchmark mode ---------- */
+static const vector<string> kAllSchedulers = {
+    "fcfs", "sjf", "srtf", "priority", "rr", "mlq", "mlfq", "lottery", "cfs", "edf"
+};
+
+struct BenchRow {
+    string scheduler;
+    int n;
+    long long decisions;
+    double min_ms, median_ms, mean_ms;
+    double ns_per_decision;   // median run / decisions
+    double growth;            // log(time ratio)/log(n ratio) vs previous size; ~1 linear, ~2 quadratic
+    long peak_rss_kb;         // RSS high-water mark above the row's starting RSS; -1 if unknown
+};
+
+static vector<string> splitList(const string& s) {
+    vector<string> out;
+    string cur;
+    stringstream ss(s);
+    while (getline(ss, cur, ',')) if (!cur.empty()) out.push_back(cur);
+    return out;
+}
+
+// one "Field:   N kB" line of /proc/self/status, or -1
+static long procStatusKb(const char* field) {
+    ifstream f("/proc/self/status");
+    string line;
+    size_t len = strlen(field);
+    while (getline(f, line))
+        if (line.compare(0, len, field) == 0 && line.size() > len && line[len] == ':')
+            return atol(line.c_str() + len + 1);
+    return -1;
+}
+
+// ru_maxrss only ever grows, so every row after the largest would repeat it.
+// Writing 5 to clear_refs resets VmHWM to the current RSS instead; returns that
+// RSS, or -1 where the kernel does not allow it.
+static long resetPeakRSSKb() {
+    malloc_trim(0);     // hand back what earlier rows freed, or later rows reuse it unseen
+    ofstream f("/proc/self/clear_refs");
+    if (!(f << "5" << flush)) return -1;
+    return procStatusKb("VmRSS");
+}
+
+static long peakRSSSinceKb(long base) {
+    long hwm = base < 0 ? -1 : procStatusKb("VmHWM");
+    return hwm < 0 ? -1 : max(0L, hwm - base);
+}
+
+static void writeBench(const vector<BenchRow>& rows, const string& file) {
+    ofstream f(file);
+    if (!f) throw runtime_error("Failed to open bench output: " + file);
+    bool json = file.size()>=5 && file.compare(file.size()-5, 5, ".json")==0;
+    if (json) {
+        f << "[\n";
+        for (size_t k=0;k<rows.size();k++) {
+            auto &r = rows[k];
+            f << "  {\"scheduler\": \"" << r.scheduler << "\", \"n\": " << r.n
+              << ", \"decisions\": " << r.decisions
+              << ", \"min_ms\": " << r.min_ms << ", \"median_ms\": " << r.median_ms
+              << ", \"mean_ms\": " << r.mean_ms << ", \"ns_per_decision\": " << r.ns_per_decision
+              << ", \"growth\": " << r.growth << ", \"peak_rss_kb\": " << r.peak_rss_kb << "}"
+              << (k+1<rows.size() ? ",\n" : "\n");
+        }
+        f << "]\n";
+    } else {
+        f << "scheduler,n,decisions,min_ms,median_ms,mean_ms,ns_per_decision,growth,peak_rss_kb\n";
+        for (auto &r : rows)
+            f << r.scheduler << "," << r.n << "," << r.decisions << "," << r.min_ms << ","
+              << r.median_ms << "," << r.mean_ms << "," << r.ns_per_decision << ","
+              << r.growth << "," << r.peak_rss_kb << "\n";
+    }
+}
+
+// Runs every selected scheduler over generateRandom(n) for each size: `warmup`
+// untimed runs, then `reps` timed runs without printing.
+static vector<BenchRow> runBench(const vector<string>& kinds, const vector<int>& sizes,
+                                 int reps, int warmup, int quantum, unsigned seed,
+                                 const SMPOptions& smp) {
+    vector<BenchRow> rows;
+    cout << left << setw(16) << "scheduler" << right << setw(10) << "n"
+         << setw(12) << "median_ms" << setw(12) << "ns/dec" << setw(8) << "growth"
+         << setw(12) << "rss_kb" << "\n";
+    for (auto &kind : kinds) {
+        auto sched = makeScheduler(kind, quantum, seed, smp);
+        double prev_ms = 0; int prev_n = 0;
+        for (int n : sizes) {
+            ProcTable ps = makeTable(generateRandom(n, seed));
+            long rssBase = resetPeakRSSKb();   // the shared workload is not charged to the engine
+            RunArrays out;
+            RunOptions quiet;
+            quiet.print = false;
+            for (int w=0; w<warmup; w++) sched->run(ps, out, quiet);
+            vector<double> ms;
+            long long decisions = 0;
+            for (int r=0; r<reps; r++) {
+                auto t0 = chrono::steady_clock::now();
+                SimResult res = sched->run(ps, out, quiet);
+                auto t1 = chrono::steady_clock::now();
+                ms.push_back(chrono::duration<double, milli>(t1 - t0).count());
+                decisions = res.decisions;
+            }
+            sort(ms.begin(), ms.end());
+            BenchRow row{sched->name(), n, decisions, ms.front(), ms[ms.size()/2],
+                         accumulate(ms.begin(), ms.end(), 0.0) / ms.size(), 0, 0, peakRSSSinceKb(rssBase)};
+            row.ns_per_decision = decisions ? row.median_ms * 1e6 / decisions : 0;
+            if (prev_n && prev_ms > 0 && n != prev_n)
+                row.growth = log(row.median_ms / prev_ms) / log((double)n / prev_n);
+            prev_ms = row.median_ms; prev_n = n;
+            cout << left << setw(16) << row.scheduler << right << setw(10) << n
+                 << setw(12) << fixed << setprecision(3) << row.median_ms
+                 << setw(12) << setprecision(1) << row.ns_per_decision
+                 << setw(8) << setprecision(2) << row.growth
+                 << setw(12) << row.peak_rss_kb << defaultfloat << setprecision(6) << "\n";
+            rows.push_back(row);
+        }
+    }
+    return rows;
+}
+
+// every timed loop folds its results into this, so none can be optimised away
+static volatile long long argminSink;
+
+// Microbenchmark for the ready-set arg-min: each op finds the minimum and re-keys
+// it (what SRTF does per decision), for every kernel this CPU supports and for the
+// binary heap the default engines use. Keys are drawn from a small range so ties
+// on key are common and the row tie-break is exercised.
+static void runArgMinBench(const vector<int>& sizes, int reps, unsigned seed) {
+    auto kernels = argminKernels();
+    cout << left << setw(10) << "kernel" << right << setw(10) << "n"
+         << setw(12) << "ns/op" << setw(12) << "ns/elem" << setw(10) << "speedup" << "\n";
+    for (int n : sizes) {
+        if (n < 1) continue;
+        mt19937 rng(seed);
+        vector<int32_t> key0(n), row(n);
+        for (int j=0; j<n; j++) { key0[j] = rng() % (n/4 + 1); row[j] = j; }
+        shuffle(row.begin(), row.end(), rng);
+        const long long ops = max(1000LL, 50000000LL / n);
+        double scalarNs = 0;
+        auto emit = [&](const string& name, double ns) {
+            if (name == "scalar") scalarNs = ns;
+            cout << left << setw(10) << name << right << setw(10) << n
+                 << setw(12) << fixed << setprecision(1) << ns << setw(12) << setprecision(3) << ns / n
+                 << setw(10) << setprecision(2) << (scalarNs ? scalarNs / ns : 0)
+                 << defaultfloat << setprecision(6) << "\n";
+        };
+        long long sink = 0;
+        for (auto &[name, fn] : kernels) {
+            vector<double> ns;
+            for (int r=0; r<reps; r++) {
+                vector<int32_t> key = key0;
+                auto t0 = chrono::steady_clock::now();
+                for (long long q=0; q<ops; q++) { int at = fn(key.data(), row.data(), n); key[at] += 1; sink += at; }
+                auto t1 = chrono::steady_clock::now();
+                ns.push_back(chrono::duration<double, nano>(t1 - t0).count() / ops);
+            }
+            sort(ns.begin(), ns.end());
+            emit(name, ns[ns.size()/2]);
+        }
+        vector<double> ns;
+        for (int r=0; r<reps; r++) {
+            HeapReadySet h;
+            for (int j=0; j<n; j++) h.push(key0[j], row[j]);
+            auto t0 = chrono::steady_clock::now();
+            for (long long q=0; q<ops; q++) { auto [k, rw] = h.q.top(); h.rekeyTop(k + 1); sink += rw; }
+            auto t1 = chrono::steady_clock::now();
+            ns.push_back(chrono::duration<double, nano>(t1 - t0).count() / ops);
+        }
+        sort(ns.begin(), ns.end());
+        emit("heap", ns[ns.size()/2]);
+        argminSink = argminSink + sink;
+    }
+}
+
+/* ---------- Parameter sweep (thread pool) ---------- */
+static bool usesQuantum(const string& kind) {
+    return kind=="rr" || kind=="roundrobin" || kind=="mlq" || kind=="lottery" || kind=="cfs";
+}
+// with a fixed input file, only lottery draws and random placement read the seed
+static bool usesSeed(const string& kind, const SMPOptions& smp) {
+    return kind=="lottery" || (smp.cpus && smp.placement=="random");
+}
+
+struct SweepTask {
+    string kind;
+    int quantum;                      // 0 when the policy has no quantum
+    unsigned seed;
+    const ProcTable* workload;        // shared, never modified
+};
+
+struct SweepRow {
+    string scheduler;
+    int quantum;
+    unsigned seed;
+    SimResult res;
+};
+
+// Every grid point runs on the shared workload for its seed; results land in the
+// slot of their task index, so the table is the same for any thread count.
+static vector<SweepRow> runSweep(const vector<SweepTask>& tasks, int threads, const SMPOptions& smp) {
+    vector<SweepRow> rows(tasks.size());
+    atomic<size_t> next{0};
+    exception_ptr err;
+    mutex err_mu;
+    auto worker = [&](){
+        for (size_t k; (k = next.fetch_add(1)) < tasks.size(); ) {
+            try {
+                auto &tk = tasks[k];
+                auto sched = makeScheduler(tk.kind, tk.quantum, tk.seed, smp);
+                RunOptions quiet;
+                quiet.print = false;
+                rows[k] = {sched->name(), tk.quantum, tk.seed, sched->run(*tk.workload, quiet)};
+            } catch (...) {
+                lock_guard<mutex> g(err_mu);
+                if (!err) err = current_exception();
+            }
+        }
+    };
+    vector<thread> pool;
+    for (int w=0; w<threads; w++) pool.emplace_back(worker);
+    for (auto &th : pool) th.join();
+    if (err) rethrow_exception(err);
+    return rows;
+}
+
+static void printSweep(const vector<SweepRow>& rows, ostream& out, bool csv) {
+    if (csv) out << "scheduler,quantum,seed,avg_wait,avg_turnaround,cpu_util,throughput,total_time\n";
+    else out << left << setw(16) << "scheduler" << right << setw(8) << "quantum" << setw(12) << "seed"
+             << setw(14) << "avg_wait" << setw(14) << "avg_turn" << setw(10) << "util%"
+             << setw(12) << "total_time" << "\n";
+    for (auto &r : rows) {
+        auto &m = r.res.metrics;
+        string q = r.quantum ? to_string(r.quantum) : "-";
+        if (csv) out << r.scheduler << "," << q << "," << r.seed << "," << m.avg_wait << ","
+                     << m.avg_turn << "," << m.cpu_util << "," << m.throughput << ","
+                     << r.res.total_time << "\n";
+        else out << left << setw(16) << r.scheduler << right << setw(8) << q << setw(12) << r.seed
+                 << setw(14) << m.avg_wait << setw(14) << m.avg_turn << setw(10) << m.cpu_util
+                 << setw(12) << r.res.total_time << "\n";
+    }
+}
+
+/* ---------- Streaming (online) mode ----------
+   Arrivals are read incrementally in arrival order and admitted as simulated
+   time reaches them. A finished job is folded into running totals, its result
+   row is written, and its slot is recycled, so memory tracks the live set
+   rather than the trace length. */
+struct StreamJob {
+    Process p;
+    long long seq;   // admission order == (arrival, id) order
+    int rem;
+    long long firstRun;  // -1 until first dispatched
+};
+
+// Reads rows one line at a time; rows sharing an arrival time are buffered and
+// sorted by id so admission order matches the batch loaders.
+class ArrivalStream {
+    istream& in;
+    string name;
+    long long line = 0;
+    bool first = true;
+    deque<Process> group;
+    optional<Process> ahead;
+    long long lastArrival = LLONG_MIN;
+
+    bool readRow(Process& p) {
+        string s;
+        while (getline(in, s)) {
+            line++;
+            RowKind k = parseCSVRow(s.data(), s.data() + s.size(), first, p);
+            if (k == RowKind::Blank) continue;
+            first = false;
+            if (k == RowKind::Header) continue;
+            if (k == RowKind::Bad) { cerr << name << ":" << line << ": malformed row skipped\n"; continue; }
+            if (p.arrival_time < lastArrival)
+                throw runtime_error(name + ":" + to_string(line) + ": arrivals must be non-decreasing in streaming mode");
+            lastArrival = p.arrival_time;
+            return true;
+        }
+        return false;
+    }
+    void fill() {
+        if (!group.empty()) return;
+        Process p;
+        if (ahead) { p = move(*ahead); ahead.reset(); }
+        else if (!readRow(p)) return;
+        group.push_back(move(p));
+        while (readRow(p)) {
+            if (p.arrival_time != group.front().arrival_time) { ahead = move(p); break; }
+            group.push_back(move(p));
+        }
+        sort(group.begin(), group.end(), [](auto&a, auto&b){ return a.id<b.id; });
+    }
+public:
+    ArrivalStream(istream& in, string name): in(in), name(move(name)) {}
+    bool more() { fill(); return !group.empty(); }
+    int nextArrival() { fill(); return group.front().arrival_time; }
+    Process take() { fill(); Process p = move(group.front()); group.pop_front(); return p; }
+};
+
+// Ready-set policy for the streaming engine. Keys carry seq, never the slot,
+// because slots are recycled.
+class OnlinePolicy {
+public:
+    virtual ~OnlinePolicy() = default;
+    virtual void push(int slot, const StreamJob& j) = 0;  // new arrival or preempted job
+    virtual int pop() = 0;
+    virtual bool empty() const = 0;
+    virtual int quantum(const StreamJob&) const { return INT_MAX; }
+    virtual bool preemptOnArrival() const { return false; }
+};
+
+class OnlineFIFO : public OnlinePolicy {        // fcfs, rr
+    queue<int> q;
+    int qt;
+public:
+    explicit OnlineFIFO(int quantum): qt(quantum) {}
+    void push(int slot, const StreamJob&) override { q.push(slot); }
+    int pop() override { int s=q.front(); q.pop(); return s; }
+    bool empty() const override { return q.empty(); }
+    int quantum(const StreamJob&) const override { return qt; }
+};
+
+class OnlineMLQ : public OnlinePolicy {         // priority < 3: RR, else FCFS
+    queue<int> highQ, lowQ;
+    int qt;
+public:
+    explicit OnlineMLQ(int quantum): qt(quantum) {}
+    void push(int slot, const StreamJob& j) override { (j.p.priority<3 ? highQ : lowQ).push(slot); }
+    int pop() override {
+        queue<int>& q = highQ.empty() ? lowQ : highQ;
+        int s=q.front(); q.pop(); return s;
+    }
+    bool empty() const override { return highQ.empty() && lowQ.empty(); }
+    int quantum(const StreamJob& j) const override { return j.p.priority<3 ? qt : INT_MAX; }
+};
+
+// min-heap on (key(job), seq): sjf (burst), srtf (remaining), edf (deadline)
+class OnlineHeap : public OnlinePolicy {
+    using Entry = tuple<long long,long long,int>;
+    priority_queue<Entry, vector<Entry>, greater<>> h;
+    function<long long(const StreamJob&)> key;
+    bool preempt;
+public:
+    OnlineHeap(function<long long(const StreamJob&)> k, bool preemptive): key(move(k)), preempt(preemptive) {}
+    void push(int slot, const StreamJob& j) override { h.push({key(j), j.seq, slot}); }
+    int pop() override { int s=get<2>(h.top()); h.pop(); return s; }
+    bool empty() const override { return h.empty(); }
+    bool preemptOnArrival() const override { return preempt; }
+};
+
+static unique_ptr<OnlinePolicy> makeOnlinePolicy(const string& kind, int quantum) {
+    string k = kind;
+    for (auto &c : k) c = tolower((unsigned char)c);
+    int q = quantum>0 ? quantum : 4;
+    if (k=="fcfs")                  return make_unique<OnlineFIFO>(INT_MAX);
+    if (k=="rr" || k=="roundrobin") return make_unique<OnlineFIFO>(q);
+    if (k=="mlq")                   return make_unique<OnlineMLQ>(q);
+    if (k=="sjf")  return make_unique<OnlineHeap>([](const StreamJob& j){ return (long long)j.p.burst_time; }, false);
+    if (k=="srtf") return make_unique<OnlineHeap>([](const StreamJob& j){ return (long long)j.rem; }, true);
+    if (k=="edf")  return make_unique<OnlineHeap>([](const StreamJob& j){ return (long long)deadlineOf(j.p); }, true);
+    throw runtime_error("Scheduler " + kind + " has no streaming engine (streaming: fcfs, sjf, srtf, rr, mlq, edf)");
 }
 
+// Writes "id,arrival,burst,completion,waiting,turnaround" per finished job and
+// returns the usual metrics; latency percentiles come from fixed-size histograms.
+static Metrics runStream(ArrivalStream& src, OnlinePolicy& pol, ostream& out) {
+    vector<StreamJob> slots;
+    vector<int> freeSlots;
+    long long t = 0, seq = 0, idle = 0;
+    MetricsAcc acc;
+    size_t peakLive = 0, live = 0;
+
+    auto admit = [&](){
+        while (src.more() && src.nextArrival() <= t) {
+            int s;
+            if (freeSlots.empty()) { s = slots.size(); slots.push_back({}); }
+            else { s = freeSlots.back(); freeSlots.pop_back(); }
+            slots[s].p = src.take();
+            slots[s].seq = seq++;
+            slots[s].rem = slots[s].p.burst_time;
+            slots[s].firstRun = -1;
+            pol.push(s, slots[s]);
+            peakLive = max(peakLive, ++live);
+        }
+    };
+
+    out << "id,arrival,burst,completion,waiting,turnaround\n";
+    while (true) {
+        admit();
+        if (pol.empty()) {
+            if (!src.more()) break;
+            idle += max(0LL, src.nextArrival() - t);
+            t = max<long long>(t, src.nextArrival());
+            continue;
+        }
+        int s = pol.pop();
+        StreamJob& j = slots[s];
+        if (j.firstRun < 0) j.firstRun = t;
+        long long ran = min(j.rem, pol.quantum(j));
+        if (pol.preemptOnArrival() && src.more()) ran = min(ran, src.nextArrival() - t);
+        t += ran; j.rem -= ran;
+        admit();    // arrivals inside the slice queue ahead of a preempted job
+        if (slots[s].rem == 0) {
+            const Process& p = slots[s].p;
+            long long turn = t - p.arrival_time, wait = turn - p.burst_time;
+            acc.add(wait, turn, slots[s].firstRun - p.arrival_time);
+            out << p.id << "," << p.arrival_time << "," << p.burst_time << ","
+                << t << "," << wait << "," << turn << "\n";
+            freeSlots.push_back(s); live--;
+        } else {
+            pol.push(s, slots[s]);
+        }
+    }
+    if (acc.jobs == 0) throw runtime_error("No processes read from stream");
+
+    Metrics m = acc.finish(t, idle, t);
+    out.flush();
+    printMetrics(m);
+    cout << "Processes: " << acc.jobs << ", peak live set: " << peakLive << "\n";
+    return m;
+}
 
 static void usage(const char* prog) {
     cerr << "Usage:\n"
          << "  " << prog << " [--input tasks.csv | --random N] "
-         << " --scheduler {fcfs|sjf|rr} [--quantum Q]\n\n"
-         << "If no input is provided, uses the lab's default 4-process table.\n";
+         << " --scheduler {fcfs|sjf|srtf|priority|rr|mlq|mlfq|lottery|cfs|edf} [--quantum Q] [--seed S]\n\n"
+         << "srtf-scan and edf-scan run the same policies on a SIMD-scanned ready set instead\n"
+         << "of a heap (same output).\n"
+         << "--quantum sets the RR/MLQ/lottery quantum and the CFS slice; --seed (default 42)\n"
+         << "seeds both --random and the lottery draws.\n"
+         << "CSV rows are id,arrival,burst[,priority[,deadline[,tickets]]] separated by commas\n"
+         << "or spaces; malformed rows are skipped and reported. --threads T (default: all\n"
+         << "cores) parses large CSVs in parallel chunks. EDF defaults the\n"
+         << "deadline to arrival + 2*burst, lottery derives tickets from priority.\n"
+         << "If no input is provided, uses the lab's default 4-process table.\n"
+         << "--random N alone draws the lab's uniform workload. --arrivals {poisson|mmpp},\n"
+         << "--bursts {uniform|pareto|lognormal} and --load L (default 0.9 per CPU) switch it to\n"
+         << "a counter-based generator that runs on --threads and gives the same table for any\n"
+         << "thread count.\n"
+         << "--convert out.wkl writes the loaded workload in the binary columnar format;\n"
+         << "--input accepts either format and mmaps binary files.\n"
+         << "--metrics-json out.json also writes the metrics (averages, busy/idle time and\n"
+         << "p50/p90/p99/p99.9/max waiting, turnaround and response) as JSON; sweeps and\n"
+         << "streaming runs accept it too.\n"
+         << "--cpus N simulates N CPUs with per-CPU runqueues (rr, cfs, priority); new jobs go\n"
+         << "to a CPU by --placement {least|rr|random} (default least) and move between CPUs\n"
+         << "by --balance {steal|T}: idle CPUs steal (default) or queues rebalance every T ticks.\n"
+         << "--trace FILE writes Gantt segments and per-process results from a background\n"
+         << "thread, as CSV or, for FILE ending in .bin, as raw 16-byte records. --no-gantt\n"
+         << "neither keeps nor prints the Gantt chart.\n"
+         << "--stats prints dispatches, context switches, idle jumps, aging promotions, the\n"
+         << "ready-queue length distribution and load/sort/simulate/output times; --perf adds\n"
+         << "cycles, instructions and cache misses over the run (perf_event_open).\n"
+         << "--checkpoint FILE --checkpoint-at T1,T2,... saves the engine state to FILE just\n"
+         << "before the first event at or after each time; --resume FILE continues from the\n"
+         << "latest snapshot that still holds for the given workload (same rows up to it, no\n"
+         << "earlier arrival), so editing the tail of a trace only re-simulates the tail.\n"
+         << "Single-CPU engines only.\n"
+         << "--count-allocs reports heap allocations made during setup and inside the event\n"
+         << "loop, and the loop's allocations per scheduling decision.\n\n"
+         << "  " << prog << " --stream {tasks.csv|-} --scheduler {fcfs|sjf|srtf|rr|mlq|edf}\n"
+         << "      [--quantum Q] [--stream-out results.csv]\n"
+         << "Online mode: reads arrival-ordered rows incrementally (\"-\" = stdin), writes each\n"
+         << "job's result as it completes and keeps memory proportional to the live set.\n\n"
+         << "  " << prog << " --bench [--scheduler LIST|all] [--bench-sizes N1,N2,...]\n"
+         << "      [--bench-reps R] [--bench-warmup W] [--bench-out results.{json|csv}]\n"
+         << "Times each scheduler on --random workloads of increasing size (median of R\n"
+         << "runs after W warm-ups) and reports ns per decision, growth exponent and peak RSS.\n\n"
+         << "  " << prog << " --bench-argmin [--bench-sizes N1,N2,...] [--bench-reps R]\n"
+         << "Times the ready-set arg-min kernels (scalar, sse4.1, avx2) against a heap.\n\n"
+         << "  " << prog << " --sweep [--input tasks.csv | --random N] [--scheduler LIST|all]\n"
+         << "      [--quanta Q1,Q2,...] [--seeds S1,S2,...] [--threads T] [--sweep-out results.csv]\n"
+         << "Runs the scheduler x quantum x seed grid on a thread pool over one shared workload\n"
+         << "(one per seed with --random) and prints a single table in grid order.\n";
 }
 
 int main(int argc, char** argv) {
@@ -264,41 +2924,239 @@ int main(int argc, char** argv) {
     string inputFile;
     int randomN = -1;
     string schedulerKind = "rr";
+    bool schedulerGiven = false;
     int quantum = 4;
+    unsigned seed = 42;
+    bool bench = false, benchArgMin = false;
+    string benchSizes = "1000,10000,100000,1000000", benchOut;
+    bool benchSizesGiven = false;
+    int benchReps = 5, benchWarmup = 1;
+    bool sweep = false, countAllocs = false, noGantt = false, wantStats = false, wantPerf = false;
+    string convertOut, metricsJson;
+    string streamIn, streamOut, traceOut;
+    string checkpointOut, checkpointAt, resumeFrom;
+    string quanta, seeds, sweepOut;
+    int threads = max(1u, thread::hardware_concurrency());
+    SMPOptions smp;
+    GenOptions gen;
+    bool genGiven = false;
 
     // parse args
     for (int i=1; i<argc; ++i) {
         string a = argv[i];
         if (a=="--input" && i+1<argc)       { inputFile = argv[++i]; }
         else if (a=="--random" && i+1<argc) { randomN = stoi(argv[++i]); }
-        else if (a=="--scheduler" && i+1<argc) { schedulerKind = argv[++i]; }
+        else if (a=="--scheduler" && i+1<argc) { schedulerKind = argv[++i]; schedulerGiven = true; }
         else if (a=="--quantum" && i+1<argc) { quantum = stoi(argv[++i]); }
+        else if (a=="--seed" && i+1<argc)   { seed = stoul(argv[++i]); }
+        else if (a=="--bench")              { bench = true; }
+        else if (a=="--bench-argmin")       { benchArgMin = true; }
+        else if (a=="--bench-sizes" && i+1<argc)  { benchSizes = argv[++i]; benchSizesGiven = true; }
+        else if (a=="--bench-reps" && i+1<argc)   { benchReps = max(1, stoi(argv[++i])); }
+        else if (a=="--bench-warmup" && i+1<argc) { benchWarmup = max(0, stoi(argv[++i])); }
+        else if (a=="--bench-out" && i+1<argc)    { benchOut = argv[++i]; }
+        else if (a=="--stream" && i+1<argc)     { streamIn = argv[++i]; }
+        else if (a=="--stream-out" && i+1<argc) { streamOut = argv[++i]; }
+        else if (a=="--convert" && i+1<argc) { convertOut = argv[++i]; }
+        else if (a=="--metrics-json" && i+1<argc) { metricsJson = argv[++i]; }
+        else if (a=="--count-allocs")       { countAllocs = true; }
+        else if (a=="--no-gantt")           { noGantt = true; }
+        else if (a=="--stats")              { wantStats = true; }
+        else if (a=="--perf")               { wantPerf = true; }
+        else if (a=="--trace" && i+1<argc)  { traceOut = argv[++i]; }
+        else if (a=="--checkpoint" && i+1<argc)    { checkpointOut = argv[++i]; }
+        else if (a=="--checkpoint-at" && i+1<argc) { checkpointAt = argv[++i]; }
+        else if (a=="--resume" && i+1<argc)        { resumeFrom = argv[++i]; }
+        else if (a=="--arrivals" && i+1<argc)   { gen.arrivals = argv[++i]; genGiven = true; }
+        else if (a=="--bursts" && i+1<argc)     { gen.bursts = argv[++i]; genGiven = true; }
+        else if (a=="--load" && i+1<argc)       { gen.load = stod(argv[++i]); genGiven = true; }
+        else if (a=="--cpus" && i+1<argc)       { smp.cpus = max(1, stoi(argv[++i])); }
+        else if (a=="--placement" && i+1<argc)  { smp.placement = argv[++i]; }
+        else if (a=="--balance" && i+1<argc)    { string v = argv[++i]; smp.balance = v=="steal" ? 0 : max(1, stoi(v)); }
+        else if (a=="--sweep")              { sweep = true; }
+        else if (a=="--quanta" && i+1<argc) { quanta = argv[++i]; }
+        else if (a=="--seeds" && i+1<argc)  { seeds = argv[++i]; }
+        else if (a=="--threads" && i+1<argc)    { threads = max(1, stoi(argv[++i])); }
+        else if (a=="--sweep-out" && i+1<argc)  { sweepOut = argv[++i]; }
         else if (a=="-h" || a=="--help")    { usage(argv[0]); return 0; }
         else { cerr << "Unknown/invalid arg: " << a << "\n"; usage(argv[0]); return 1; }
     }
 
-    vector<Process> processes;
+    if (benchArgMin) {
+        try {
+            vector<int> sizes;
+            for (auto &v : splitList(benchSizesGiven ? benchSizes : "16,64,256,1024,4096,16384"))
+                sizes.push_back(stoi(v));
+            runArgMinBench(sizes, benchReps, seed);
+        } catch (const exception& e) {
+            cerr << e.what() << "\n"; return 1;
+        }
+        return 0;
+    }
+
+    if (bench) {
+        try {
+            vector<string> kinds = (schedulerKind=="all" || !schedulerGiven)
+                ? kAllSchedulers : splitList(schedulerKind);
+            vector<int> sizes;
+            for (auto &v : splitList(benchSizes)) sizes.push_back(stoi(v));
+            auto rows = runBench(kinds, sizes, benchReps, benchWarmup, quantum, seed, smp);
+            if (!benchOut.empty()) writeBench(rows, benchOut);
+        } catch (const exception& e) {
+            cerr << e.what() << "\n"; return 1;
+        }
+        return 0;
+    }
+
+    if (!streamIn.empty()) {
+        try {
+            auto pol = makeOnlinePolicy(schedulerKind, quantum);
+            ifstream fin;
+            if (streamIn != "-") {
+                fin.open(streamIn);
+                if (!fin) throw runtime_error("Failed to open input file: " + streamIn);
+            }
+            ArrivalStream src(streamIn=="-" ? cin : fin, streamIn=="-" ? "<stdin>" : streamIn);
+            ofstream fout;
+            if (!streamOut.empty()) {
+                fout.open(streamOut);
+                if (!fout) throw runtime_error("Failed to open output file: " + streamOut);
+            }
+            cout << "Scheduler: " << schedulerKind << " (streaming)\n";
+            Metrics m = runStream(src, *pol, streamOut.empty() ? cout : fout);
+            if (!metricsJson.empty())
+                writeMetricsFile(metricsJson, {{"\"scheduler\": \"" + schedulerKind + "\", ", m}});
+        } catch (const exception& e) {
+            cerr << e.what() << "\n"; return 1;
+        }
+        return 0;
+    }
+
+    // --random: the lab's uniform generator unless a distribution or load is given
+    gen.cpus = max(1, smp.cpus);
+    auto randomTable = [&](unsigned sd) {
+        return genGiven ? generateWorkload(randomN, gen, sd, threads) : makeTable(generateRandom(randomN, sd));
+    };
+
+    // load and sort are timed apart for --stats; binary and generated tables need no sort
+    SchedStats stats;
+    ProcTable processes;
     try {
+        auto t0 = chrono::steady_clock::now();
+        vector<Process> rows;
         if (!inputFile.empty()) {
-            processes = loadCSV(inputFile);
+            if (isBinaryWorkload(inputFile)) processes = loadBinaryWorkload(inputFile);
+            else rows = loadCSV(inputFile, threads);
         } else if (randomN > 0) {
-            processes = generateRandom(randomN);
+            if (genGiven) processes = randomTable(seed);
+            else rows = generateRandom(randomN, seed);
         } else {
-            processes = defaultTable();
+            rows = defaultTable();
+        }
+        stats.loadMs = msSince(t0);
+        if (!rows.empty()) {
+            t0 = chrono::steady_clock::now();
+            processes = makeTable(move(rows));
+            stats.sortMs = msSince(t0);
+        }
+        if (!convertOut.empty()) {
+            writeBinaryWorkload(processes, convertOut);
+            cerr << "Wrote " << processes.size() << " processes to " << convertOut << "\n";
+            return 0;
         }
     } catch (const exception& e) {
         cerr << e.what() << "\n"; return 1;
     }
 
-    // Ensure remaining_time is set
-    for (auto &p : processes) p.remaining_time = p.burst_time;
+    if (sweep) {
+        try {
+            vector<string> kinds = (schedulerKind=="all" || !schedulerGiven)
+                ? kAllSchedulers : splitList(schedulerKind);
+            vector<int> qs;
+            for (auto &v : splitList(quanta.empty() ? to_string(quantum) : quanta)) qs.push_back(stoi(v));
+            vector<unsigned> ss;
+            for (auto &v : splitList(seeds.empty() ? to_string(seed) : seeds)) ss.push_back(stoul(v));
+
+            // parse/generate once; --random gets one workload per seed
+            map<unsigned, ProcTable> perSeed;
+            if (inputFile.empty() && randomN > 0)
+                for (unsigned sd : ss) perSeed[sd] = randomTable(sd);
+
+            vector<SweepTask> tasks;
+            for (auto &k : kinds)
+                for (int q : usesQuantum(k) ? qs : vector<int>{0})
+                    for (unsigned sd : perSeed.empty() && !usesSeed(k, smp) ? vector<unsigned>{ss[0]} : ss)
+                        tasks.push_back({k, q, sd, perSeed.empty() ? &processes : &perSeed[sd]});
+            auto rows = runSweep(tasks, threads, smp);
+            printSweep(rows, cout, false);
+            if (!sweepOut.empty()) {
+                ofstream f(sweepOut);
+                if (!f) throw runtime_error("Failed to open sweep output: " + sweepOut);
+                printSweep(rows, f, true);
+            }
+            if (!metricsJson.empty()) {
+                vector<pair<string, Metrics>> runs;
+                for (auto &r : rows)
+                    runs.push_back({"\"scheduler\": \"" + r.scheduler + "\", \"quantum\": " + to_string(r.quantum)
+                                    + ", \"seed\": " + to_string(r.seed) + ", \"total_time\": "
+                                    + to_string(r.res.total_time) + ", ", r.res.metrics});
+                writeMetricsFile(metricsJson, runs);
+            }
+        } catch (const exception& e) {
+            cerr << e.what() << "\n"; return 1;
+        }
+        return 0;
+    }
 
     try {
-        auto sched = makeScheduler(schedulerKind, quantum);
+        auto sched = makeScheduler(schedulerKind, quantum, seed, smp);
         cout << "Scheduler: " << sched->name() << "\n";
-        // (Run returns SimResult but we already print inside; kept for later logging)
-        SimResult res = sched->run(processes);
-        (void)res;
+        unique_ptr<TraceWriter> trace;
+        if (!traceOut.empty()) trace = make_unique<TraceWriter>(processes, traceOut);
+        RunOptions opt;
+        opt.gantt = !noGantt;
+        opt.trace = trace.get();
+        if (wantStats) opt.stats = &stats;
+        if ((!checkpointOut.empty() || !resumeFrom.empty()) && smp.cpus)
+            throw runtime_error("--checkpoint and --resume need a single-CPU engine (no --cpus)");
+        if (checkpointOut.empty() != checkpointAt.empty())
+            throw runtime_error("--checkpoint FILE and --checkpoint-at T1,T2,... go together");
+        // read the snapshot first: --checkpoint may name the same file
+        Snapshot snap;
+        if (!resumeFrom.empty()) {
+            if (findSnapshot(resumeFrom, processes, sched->name(), snap)) {
+                opt.resume = &snap;
+                cerr << "Resuming at t=" << snap.time << " with " << snap.cut << " of "
+                     << processes.size() << " processes arrived\n";
+            } else {
+                cerr << "No snapshot in " << resumeFrom << " matches this workload; starting at t=0\n";
+            }
+        }
+        unique_ptr<Checkpointer> checkpoint;
+        if (!checkpointOut.empty()) {
+            vector<int> at;
+            for (auto &v : splitList(checkpointAt)) at.push_back(stoi(v));
+            checkpoint = make_unique<Checkpointer>(checkpointOut, move(at));
+            opt.checkpoint = checkpoint.get();
+        }
+        unique_ptr<PerfCounters> perf;
+        if (wantPerf) { perf = make_unique<PerfCounters>(); perf->start(); }
+        SimResult res = sched->run(processes, opt);
+        if (perf) perf->stop(stats);
+        if (trace) {
+            auto t0 = chrono::steady_clock::now();
+            trace->close();
+            stats.outputMs += msSince(t0);
+        }
+        if (checkpoint) cerr << "Wrote " << checkpoint->taken << " snapshots to " << checkpointOut << "\n";
+        if (wantStats || wantPerf) printStats(stats, wantStats);
+        if (countAllocs)
+            cout << "Allocations: setup " << res.setupAllocs << ", event loop " << res.loopAllocs
+                 << " (" << (res.decisions ? (double)res.loopAllocs / res.decisions : 0.0) << " per decision)\n";
+        if (!metricsJson.empty())
+            writeMetricsFile(metricsJson, {{"\"scheduler\": \"" + sched->name() + "\", \"processes\": "
+                + to_string(processes.size()) + ", \"total_time\": " + to_string(res.total_time)
+                + ", \"decisions\": " + to_string(res.decisions) + ", ", res.metrics}});
     } catch (const exception& e) {
         cerr << e.what() << "\n"; return 1;
     }